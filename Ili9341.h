@@ -44,9 +44,15 @@
 #define LCD_D7_PORT     GPIOA
 #define LCD_D7_PIN      GPIO_PIN_8
 
-// Screen dimensions
-#define ILI9341_WIDTH       240
-#define ILI9341_HEIGHT      320
+// Panel geometry (portrait, MADCTL 0x48)
+#define ILI9341_PANEL_W     240
+#define ILI9341_PANEL_H     320
+#define ILI9488_PANEL_W     320
+#define ILI9488_PANEL_H     480
+
+// Screen dimensions of the panel passed to ILI9341_InitPanel
+#define ILI9341_WIDTH       (ili9341_panel->width)
+#define ILI9341_HEIGHT      (ili9341_panel->height)
 
 // Colors (RGB565 format)
 #define BLACK   0x0000
@@ -81,6 +87,7 @@
 #define ILI9341_RAMWR       0x2C
 #define ILI9341_RAMRD       0x2E
 #define ILI9341_PTLAR       0x30
+#define ILI9341_VSCRDEF     0x33
 #define ILI9341_MADCTL      0x36
 #define ILI9341_VSCRSADD    0x37
 #define ILI9341_PIXFMT      0x3A
@@ -103,12 +110,70 @@
 #define ILI9341_GMCTRP1     0xE0
 #define ILI9341_GMCTRN1     0xE1
 
+// RDMODE (0x0A) bits
+#define ILI9341_MODE_BOOSTER 0x80
+#define ILI9341_MODE_SLPOUT  0x10
+#define ILI9341_MODE_NORON   0x08
+#define ILI9341_MODE_DISPON  0x04
+
+// Init table: { cmd, n [| ILI9341_INIT_DELAY], n args, [delay ms] } ... ILI9341_INIT_END
+#define ILI9341_INIT_DELAY  0x80     // a delay byte (ms) follows the arguments
+#define ILI9341_INIT_END    0xFF
+
+// Panel descriptor: everything that differs between controllers on the same 8080 bus
+typedef struct {
+    const char *name;
+    uint16_t width, height;
+    uint8_t pixfmt;          // COLMOD, sent after init; 0x55 = RGB565 (2 bus bytes per pixel)
+    const uint8_t *init;     // Sent after the hardware reset, without COLMOD
+    const uint8_t *fade_lit; // Fade register sets (init-table format, same commands and
+    const uint8_t *fade_dim; // argument counts), blended by ILI9341_FadeArg
+} ILI9341_Panel_t;
+
+extern const ILI9341_Panel_t ili9341_panel_240x320;
+extern const ILI9341_Panel_t ili9488_panel_320x480;
+extern const ILI9341_Panel_t *ili9341_panel;   // Active panel
+
+// 5x7 font (ASCII 32-126), one byte per column, LSB = top row
+extern const uint8_t font5x7[][5];
+
+// Text field: remembers what it last drew so updates only touch changed cells
+#define ILI9341_CHAR_W          6    // 5 pixel glyph + 1 pixel spacing
+#define ILI9341_CHAR_H          8
+#define ILI9341_TEXTFIELD_MAX   40   // 240 / 6 characters per line
+
+typedef struct {
+    uint16_t x, y;
+    uint16_t color, bgcolor;
+    uint8_t max_len;
+    uint8_t len;
+    char text[ILI9341_TEXTFIELD_MAX + 1];
+} ILI9341_TextField_t;
+
+// Console: scroll area used as a circular line buffer in GRAM (VSCRDEF/VSCRSADD)
+typedef struct {
+    uint16_t top;          // Fixed rows above the console (TFA)
+    uint16_t height;       // Scroll area rows (VSA), multiple of ILI9341_CHAR_H
+    uint8_t lines;         // Text lines in the scroll area
+    uint8_t count;         // Lines written until the area is first full
+    uint8_t head;          // Slot of the oldest visible line once full
+    uint16_t color, bgcolor;
+} ILI9341_Console_t;
+
 // Function prototypes
 void ILI9341_Init(void);
+void ILI9341_InitPanel(const ILI9341_Panel_t *panel);
+uint8_t ILI9341_FadeArg(uint8_t cmd, uint8_t index, uint8_t lit, uint8_t dim, uint8_t level);
+void ILI9341_SetFade(uint8_t level);
+int16_t ILI9341_InitArg(const ILI9341_Panel_t *panel, uint8_t cmd);
+uint8_t ILI9341_IsConfigured(const ILI9341_Panel_t *panel, const uint8_t *rddst);
+void ILI9341_Park(void);
+uint8_t ILI9341_Resume(const ILI9341_Panel_t *panel);
 void ILI9341_WriteCommand(uint8_t cmd);
 void ILI9341_WriteData(uint8_t data);
 void ILI9341_WriteData16(uint16_t data);
 uint8_t ILI9341_ReadData(void);
+void ILI9341_ReadReg(uint8_t cmd, uint8_t *buf, uint8_t n);
 void ILI9341_SetAddress(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 void ILI9341_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
 void ILI9341_Fill(uint16_t color);
@@ -118,6 +183,16 @@ void ILI9341_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t c
 void ILI9341_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color);
 void ILI9341_DrawChar(uint16_t x, uint16_t y, char ch, uint16_t color, uint16_t bgcolor);
 void ILI9341_DrawString(uint16_t x, uint16_t y, char* str, uint16_t color, uint16_t bgcolor);
+void ILI9341_DrawCharFast(uint16_t x, uint16_t y, char ch, uint16_t color, uint16_t bgcolor);
+void ILI9341_TextField_Init(ILI9341_TextField_t *tf, uint16_t x, uint16_t y, uint8_t max_len, uint16_t color, uint16_t bgcolor);
+void ILI9341_TextField_Update(ILI9341_TextField_t *tf, const char *str);
+void ILI9341_TextField_Redraw(ILI9341_TextField_t *tf);
+void ILI9341_SetScrollArea(uint16_t top, uint16_t height, uint16_t bottom);
+void ILI9341_SetScrollStart(uint16_t line);
+void ILI9341_Console_Init(ILI9341_Console_t *con, uint16_t top, uint16_t height, uint16_t color, uint16_t bgcolor);
+void ILI9341_Console_Print(ILI9341_Console_t *con, const char *str);
+void ILI9341_Console_Clear(ILI9341_Console_t *con);
+void ILI9341_Console_Close(ILI9341_Console_t *con);
 
 //#endif
 
@@ -0,0 +1,138 @@
+/*
+ * eye_proto.c
+ *
+ * Byte-at-a-time frame parser and encoder for eye_proto.h.
+ * Safe to call from an interrupt: no allocation, no blocking, O(1) per byte.
+ */
+
+#include "eye_proto.h"
+#include <string.h>
+
+enum {
+    ST_SYNC = 0,
+    ST_CMD,
+    ST_SEQ,
+    ST_LEN,
+    ST_PAYLOAD,
+    ST_CRC
+};
+
+// CRC-8, polynomial 0x07, init 0
+uint8_t Proto_Crc8(uint8_t crc, uint8_t byte) {
+    crc ^= byte;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+void Proto_Init(Proto_Parser_t *p, uint8_t sync) {
+    memset(p, 0, sizeof(*p));
+    p->sync = sync;
+}
+
+// Feed one received byte. Anything that is not a sync byte between frames is skipped,
+// so a broken frame only costs the bytes up to the next sync.
+uint8_t Proto_Feed(Proto_Parser_t *p, uint8_t byte) {
+    switch (p->state) {
+    case ST_SYNC:
+        if (byte == p->sync) {
+            p->crc = 0;
+            p->state = ST_CMD;
+        }
+        return PROTO_NONE;
+
+    case ST_CMD:
+        p->frame.cmd = byte;
+        p->crc = Proto_Crc8(p->crc, byte);
+        p->state = ST_SEQ;
+        return PROTO_NONE;
+
+    case ST_SEQ:
+        p->frame.seq = byte;
+        p->crc = Proto_Crc8(p->crc, byte);
+        p->state = ST_LEN;
+        return PROTO_NONE;
+
+    case ST_LEN:
+        if (byte > PROTO_MAX_PAYLOAD) {
+            p->state = ST_SYNC;
+            p->error = PROTO_ERR_LEN;
+            p->bad++;
+            return PROTO_BAD;
+        }
+        p->frame.len = byte;
+        p->crc = Proto_Crc8(p->crc, byte);
+        p->pos = 0;
+        p->state = byte ? ST_PAYLOAD : ST_CRC;
+        return PROTO_NONE;
+
+    case ST_PAYLOAD:
+        p->frame.payload[p->pos++] = byte;
+        p->crc = Proto_Crc8(p->crc, byte);
+        if (p->pos >= p->frame.len) p->state = ST_CRC;
+        return PROTO_NONE;
+
+    case ST_CRC:
+    default:
+        p->state = ST_SYNC;
+        if (byte != p->crc) {
+            p->error = PROTO_ERR_CRC;
+            p->bad++;
+            return PROTO_BAD;
+        }
+        p->frames++;
+        return PROTO_FRAME;
+    }
+}
+
+// Command and payload length check (argument ranges are up to the receiver)
+uint8_t Proto_Check(const Proto_Frame_t *f) {
+    switch (f->cmd) {
+    case PROTO_CMD_PING:   return (f->len == 0) ? PROTO_OK : PROTO_ERR_LEN;
+    case PROTO_CMD_EXPR:   return (f->len == 1) ? PROTO_OK : PROTO_ERR_LEN;
+    case PROTO_CMD_GAZE:   return (f->len == 2) ? PROTO_OK : PROTO_ERR_LEN;
+    case PROTO_CMD_BLINK:
+        if (f->len != 1) return PROTO_ERR_LEN;
+        return (f->payload[0] <= 2) ? PROTO_OK : PROTO_ERR_ARG;
+    case PROTO_CMD_TEXT:   return PROTO_OK;    // 0..PROTO_MAX_PAYLOAD already enforced
+    case PROTO_CMD_BRIGHT: return (f->len == 1) ? PROTO_OK : PROTO_ERR_LEN;
+    default:               return PROTO_ERR_CMD;
+    }
+}
+
+// out must hold len + PROTO_OVERHEAD bytes, returns the frame size
+size_t Proto_Encode(uint8_t *out, uint8_t sync, uint8_t cmd, uint8_t seq,
+                    const uint8_t *payload, uint8_t len) {
+    uint8_t crc = 0;
+    size_t n = 0;
+
+    if (len > PROTO_MAX_PAYLOAD) len = PROTO_MAX_PAYLOAD;
+    out[n++] = sync;
+    out[n++] = cmd;  crc = Proto_Crc8(crc, cmd);
+    out[n++] = seq;  crc = Proto_Crc8(crc, seq);
+    out[n++] = len;  crc = Proto_Crc8(crc, len);
+    for (uint8_t i = 0; i < len; i++) {
+        out[n++] = payload[i];
+        crc = Proto_Crc8(crc, payload[i]);
+    }
+    out[n++] = crc;
+    return n;
+}
+
+size_t Proto_EncodeReply(uint8_t *out, uint8_t cmd, uint8_t seq, uint8_t status, uint32_t latency_us) {
+    uint8_t pl[5];
+
+    pl[0] = status;
+    pl[1] = (uint8_t)latency_us;
+    pl[2] = (uint8_t)(latency_us >> 8);
+    pl[3] = (uint8_t)(latency_us >> 16);
+    pl[4] = (uint8_t)(latency_us >> 24);
+    return Proto_Encode(out, PROTO_REPLY_SYNC, cmd, seq, pl, sizeof(pl));
+}
+
+uint32_t Proto_ReplyLatency(const Proto_Frame_t *f) {
+    if (f->len < 5) return 0;
+    return (uint32_t)f->payload[1] | ((uint32_t)f->payload[2] << 8) |
+           ((uint32_t)f->payload[3] << 16) | ((uint32_t)f->payload[4] << 24);
+}
@@ -0,0 +1,81 @@
+/*
+ * eye_proto.h
+ *
+ * Compact binary command protocol for the robot eye (UART).
+ * No HAL dependency: shared by main.c (USART2) and tools/protohost.c (Linux).
+ *
+ * Command frame (host -> eye):
+ *   0xA5 | cmd | seq | len | payload[len] | crc8(cmd .. payload)
+ *
+ * Reply frame (eye -> host), one per command:
+ *   0x5A | cmd | seq | 5 | status | latency_us (u32 LE) | crc8(cmd .. payload)
+ *
+ * latency_us is measured on the eye from the last received byte of the
+ * command to the end of the frame that shows it (command-to-photon).
+ */
+
+#ifndef INC_EYE_PROTO_H_
+#define INC_EYE_PROTO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PROTO_SYNC          0xA5
+#define PROTO_REPLY_SYNC    0x5A
+#define PROTO_MAX_PAYLOAD   32
+#define PROTO_OVERHEAD      5        // sync + cmd + seq + len + crc
+#define PROTO_FRAME_MAX     (PROTO_MAX_PAYLOAD + PROTO_OVERHEAD)
+#define PROTO_REPLY_LEN     (5 + PROTO_OVERHEAD)
+
+// Commands
+#define PROTO_CMD_PING      0x00     // no payload, replied straight from the receiver
+#define PROTO_CMD_EXPR      0x01     // u8 expression (Expression_t in main.c)
+#define PROTO_CMD_GAZE      0x02     // i8 ox, i8 oy, each within +-8 (EYE_GAZE_MAX in main.c);
+                                     // a newer target replaces a pending one
+#define PROTO_CMD_BLINK     0x03     // u8 0 = both, 1 = wink left, 2 = wink right
+#define PROTO_CMD_TEXT      0x04     // status line text, 0..32 chars (not NUL terminated)
+#define PROTO_CMD_BRIGHT    0x05     // u8 brightness 0..255
+#define PROTO_CMD_COUNT     0x06
+
+// Reply status
+#define PROTO_OK            0x00
+#define PROTO_ERR_CRC       0x01
+#define PROTO_ERR_CMD       0x02     // unknown command
+#define PROTO_ERR_LEN       0x03     // wrong payload length for the command
+#define PROTO_ERR_ARG       0x04     // argument out of range
+#define PROTO_ERR_BUSY      0x05     // event queue full, command dropped
+#define PROTO_REPLACED      0x06     // gaze target superseded before it was shown
+
+// Proto_Feed results
+#define PROTO_NONE          0
+#define PROTO_FRAME         1        // complete frame in p->frame
+#define PROTO_BAD           2        // broken frame, p->error says why
+
+typedef struct {
+    uint8_t cmd;
+    uint8_t seq;
+    uint8_t len;
+    uint8_t payload[PROTO_MAX_PAYLOAD];
+} Proto_Frame_t;
+
+typedef struct {
+    uint8_t sync;            // PROTO_SYNC on the eye, PROTO_REPLY_SYNC on the host
+    uint8_t state;
+    uint8_t pos;
+    uint8_t crc;
+    uint8_t error;           // status of the last PROTO_BAD
+    Proto_Frame_t frame;
+    uint32_t frames;
+    uint32_t bad;
+} Proto_Parser_t;
+
+void Proto_Init(Proto_Parser_t *p, uint8_t sync);
+uint8_t Proto_Feed(Proto_Parser_t *p, uint8_t byte);
+uint8_t Proto_Check(const Proto_Frame_t *f);
+uint8_t Proto_Crc8(uint8_t crc, uint8_t byte);
+size_t Proto_Encode(uint8_t *out, uint8_t sync, uint8_t cmd, uint8_t seq,
+                    const uint8_t *payload, uint8_t len);
+size_t Proto_EncodeReply(uint8_t *out, uint8_t cmd, uint8_t seq, uint8_t status, uint32_t latency_us);
+uint32_t Proto_ReplyLatency(const Proto_Frame_t *f);
+
+#endif /* INC_EYE_PROTO_H_ */
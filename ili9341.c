@@ -1,5 +1,6 @@
 #include "ili9341.h"
 #include <math.h>
+#include <stdlib.h>
 
 // Complete 5x7 font data (ASCII 32-126)
 const uint8_t font5x7[][5] = {
@@ -241,7 +242,132 @@ uint8_t ILI9341_ReadData(void) {
     return data;
 }
 
+// Read command: cmd, one dummy read, then n parameter bytes
+void ILI9341_ReadReg(uint8_t cmd, uint8_t *buf, uint8_t n) {
+    CS_LOW();
+    RS_LOW();  // Command mode
+    ILI9341_WriteData8(cmd);
+    RS_HIGH(); // Data mode
+    ILI9341_SetDataPinsInput();
+    (void)ILI9341_ReadData8();
+    for (uint8_t i = 0; i < n; i++) {
+        buf[i] = ILI9341_ReadData8();
+    }
+    CS_HIGH();
+    ILI9341_SetDataPinsOutput();
+}
+
+// ILI9341 240x320
+static const uint8_t ili9341_init[] = {
+    ILI9341_SWRESET, 0 | ILI9341_INIT_DELAY, 150,
+    ILI9341_SLPOUT, 0 | ILI9341_INIT_DELAY, 120,
+    0xCF, 3, 0x00, 0xC1, 0x30,                      // Power control B
+    0xED, 4, 0x64, 0x03, 0x12, 0x81,                // Power on sequence control
+    0xE8, 3, 0x85, 0x00, 0x78,                      // Driver timing control A
+    0xCB, 5, 0x39, 0x2C, 0x00, 0x34, 0x02,          // Power control A
+    0xF7, 1, 0x20,                                  // Pump ratio control
+    0xEA, 2, 0x00, 0x00,                            // Driver timing control B
+    ILI9341_PWCTR1, 1, 0x23,
+    ILI9341_PWCTR2, 1, 0x10,
+    ILI9341_VMCTR1, 2, 0x3E, 0x28,
+    ILI9341_VMCTR2, 1, 0x86,
+    ILI9341_MADCTL, 1, 0x48,
+    ILI9341_FRMCTR1, 2, 0x00, 0x18,
+    ILI9341_DFUNCTR, 3, 0x08, 0x82, 0x27,
+    0xF2, 1, 0x00,                                  // Gamma function disable
+    ILI9341_GAMMASET, 1, 0x01,
+    ILI9341_GMCTRP1, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                         0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+    ILI9341_GMCTRN1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                         0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+    ILI9341_SLPOUT, 0 | ILI9341_INIT_DELAY, 120,
+    ILI9341_DISPON, 0 | ILI9341_INIT_DELAY, 50,
+    ILI9341_INIT_END
+};
+
+// ILI9488 320x480 (8080 8-bit interface, which unlike SPI accepts RGB565)
+static const uint8_t ili9488_init[] = {
+    ILI9341_SWRESET, 0 | ILI9341_INIT_DELAY, 150,
+    ILI9341_GMCTRP1, 15, 0x00, 0x03, 0x09, 0x08, 0x16, 0x0A, 0x3F, 0x78,
+                         0x4C, 0x09, 0x0A, 0x08, 0x16, 0x1A, 0x0F,
+    ILI9341_GMCTRN1, 15, 0x00, 0x16, 0x19, 0x03, 0x0F, 0x05, 0x32, 0x45,
+                         0x46, 0x04, 0x0E, 0x0D, 0x35, 0x37, 0x0F,
+    ILI9341_PWCTR1, 2, 0x17, 0x15,
+    ILI9341_PWCTR2, 1, 0x41,
+    ILI9341_VMCTR1, 3, 0x00, 0x12, 0x80,
+    ILI9341_MADCTL, 1, 0x48,
+    0xB0, 1, 0x00,                                  // Interface mode control
+    ILI9341_FRMCTR1, 1, 0xA0,
+    ILI9341_INVCTR, 1, 0x02,                        // 2-dot inversion
+    ILI9341_DFUNCTR, 3, 0x02, 0x02, 0x3B,
+    0xE9, 1, 0x00,                                  // Set image function: 24-bit data bus off
+    0xF7, 4, 0xA9, 0x51, 0x2C, 0x82,                // Adjust control 3
+    ILI9341_SLPOUT, 0 | ILI9341_INIT_DELAY, 120,
+    ILI9341_DISPON, 0 | ILI9341_INIT_DELAY, 50,
+    ILI9341_INIT_END
+};
+
+// Fade sets: lit = the init values, dim = GVDD at its minimum with VCOMH following it,
+// and every gamma field scaled to 1/4 so the grey levels crowd towards black.
+// The dim values are a starting point; check them on the actual module.
+static const uint8_t ili9341_fade_lit[] = {
+    ILI9341_PWCTR1, 1, 0x23,
+    ILI9341_VMCTR1, 2, 0x3E, 0x28,
+    ILI9341_GMCTRP1, 15, 0x0F, 0x31, 0x2B, 0x0C, 0x0E, 0x08, 0x4E, 0xF1,
+                         0x37, 0x07, 0x10, 0x03, 0x0E, 0x09, 0x00,
+    ILI9341_GMCTRN1, 15, 0x00, 0x0E, 0x14, 0x03, 0x11, 0x07, 0x31, 0xC1,
+                         0x48, 0x08, 0x0F, 0x0C, 0x31, 0x36, 0x0F,
+    ILI9341_INIT_END
+};
+
+static const uint8_t ili9341_fade_dim[] = {
+    ILI9341_PWCTR1, 1, 0x03,                        // GVDD 3.00 V
+    ILI9341_VMCTR1, 2, 0x02, 0x28,                  // VCOMH 2.75 V
+    ILI9341_GMCTRP1, 15, 0x03, 0x0C, 0x0A, 0x03, 0x03, 0x02, 0x13, 0x30,
+                         0x0D, 0x01, 0x04, 0x00, 0x03, 0x02, 0x00,
+    ILI9341_GMCTRN1, 15, 0x00, 0x03, 0x05, 0x00, 0x04, 0x01, 0x0C, 0x30,
+                         0x12, 0x02, 0x03, 0x03, 0x0C, 0x0D, 0x03,
+    ILI9341_INIT_END
+};
+
+// ILI9488: gamma only, the power register steps are not characterised yet
+static const uint8_t ili9488_fade_lit[] = {
+    ILI9341_GMCTRP1, 15, 0x00, 0x03, 0x09, 0x08, 0x16, 0x0A, 0x3F, 0x78,
+                         0x4C, 0x09, 0x0A, 0x08, 0x16, 0x1A, 0x0F,
+    ILI9341_GMCTRN1, 15, 0x00, 0x16, 0x19, 0x03, 0x0F, 0x05, 0x32, 0x45,
+                         0x46, 0x04, 0x0E, 0x0D, 0x35, 0x37, 0x0F,
+    ILI9341_INIT_END
+};
+
+static const uint8_t ili9488_fade_dim[] = {
+    ILI9341_GMCTRP1, 15, 0x00, 0x00, 0x02, 0x02, 0x05, 0x02, 0x0F, 0x12,
+                         0x13, 0x02, 0x02, 0x02, 0x05, 0x06, 0x03,
+    ILI9341_GMCTRN1, 15, 0x00, 0x05, 0x06, 0x00, 0x03, 0x01, 0x0C, 0x11,
+                         0x11, 0x01, 0x03, 0x03, 0x0D, 0x0D, 0x03,
+    ILI9341_INIT_END
+};
+
+const ILI9341_Panel_t ili9341_panel_240x320 = {
+    "ILI9341", ILI9341_PANEL_W, ILI9341_PANEL_H, 0x55, ili9341_init,
+    ili9341_fade_lit, ili9341_fade_dim
+};
+
+const ILI9341_Panel_t ili9488_panel_320x480 = {
+    "ILI9488", ILI9488_PANEL_W, ILI9488_PANEL_H, 0x55, ili9488_init,
+    ili9488_fade_lit, ili9488_fade_dim
+};
+
+const ILI9341_Panel_t *ili9341_panel = &ili9341_panel_240x320;
+
 void ILI9341_Init(void) {
+    ILI9341_InitPanel(&ili9341_panel_240x320);
+}
+
+void ILI9341_InitPanel(const ILI9341_Panel_t *panel) {
+    const uint8_t *p = panel->init;
+
+    ili9341_panel = panel;
+
     // Initialize control pins
     RD_HIGH();
     WR_HIGH();
@@ -258,138 +384,110 @@ void ILI9341_Init(void) {
     RST_HIGH();
     HAL_Delay(120);
 
-    // Software reset
-    ILI9341_WriteCommand(ILI9341_SWRESET);
-    HAL_Delay(150);
-
-    // Power control A
-    ILI9341_WriteCommand(0xCB);
-    ILI9341_WriteData(0x39);
-    ILI9341_WriteData(0x2C);
-    ILI9341_WriteData(0x00);
-    ILI9341_WriteData(0x34);
-    ILI9341_WriteData(0x02);
-
-    // Power control B
-    ILI9341_WriteCommand(0xCF);
-    ILI9341_WriteData(0x00);
-    ILI9341_WriteData(0xC1);
-    ILI9341_WriteData(0x30);
-
-    // Driver timing control A
-    ILI9341_WriteCommand(0xE8);
-    ILI9341_WriteData(0x85);
-    ILI9341_WriteData(0x00);
-    ILI9341_WriteData(0x78);
-
-    // Driver timing control B
-    ILI9341_WriteCommand(0xEA);
-    ILI9341_WriteData(0x00);
-    ILI9341_WriteData(0x00);
-
-    // Power on sequence control
-    ILI9341_WriteCommand(0xED);
-    ILI9341_WriteData(0x64);
-    ILI9341_WriteData(0x03);
-    ILI9341_WriteData(0x12);
-    ILI9341_WriteData(0x81);
-
-    // Pump ratio control
-    ILI9341_WriteCommand(0xF7);
-    ILI9341_WriteData(0x20);
-
-    // Power control 1
-    ILI9341_WriteCommand(ILI9341_PWCTR1);
-    ILI9341_WriteData(0x23);
-
-    // Power control 2
-    ILI9341_WriteCommand(ILI9341_PWCTR2);
-    ILI9341_WriteData(0x10);
-
-    // VCOM control 1
-    ILI9341_WriteCommand(ILI9341_VMCTR1);
-    ILI9341_WriteData(0x3E);
-    ILI9341_WriteData(0x28);
-
-    // VCOM control 2
-    ILI9341_WriteCommand(ILI9341_VMCTR2);
-    ILI9341_WriteData(0x86);
-
-    // Memory access control
-    ILI9341_WriteCommand(ILI9341_MADCTL);
-    ILI9341_WriteData(0x48);
+    while (*p != ILI9341_INIT_END) {
+        uint8_t cmd = *p++;
+        uint8_t n = *p++;
+
+        ILI9341_WriteCommand(cmd);
+        for (uint8_t i = 0; i < (n & ~ILI9341_INIT_DELAY); i++) {
+            ILI9341_WriteData(*p++);
+        }
+        if (n & ILI9341_INIT_DELAY) HAL_Delay(*p++);
+    }
 
     // Pixel format
     ILI9341_WriteCommand(ILI9341_PIXFMT);
-    ILI9341_WriteData(0x55);
-
-    // Frame rate control
-    ILI9341_WriteCommand(ILI9341_FRMCTR1);
-    ILI9341_WriteData(0x00);
-    ILI9341_WriteData(0x18);
-
-    // Display function control
-    ILI9341_WriteCommand(ILI9341_DFUNCTR);
-    ILI9341_WriteData(0x08);
-    ILI9341_WriteData(0x82);
-    ILI9341_WriteData(0x27);
-
-    // Gamma function disable
-    ILI9341_WriteCommand(0xF2);
-    ILI9341_WriteData(0x00);
-
-    // Gamma curve
-    ILI9341_WriteCommand(ILI9341_GAMMASET);
-    ILI9341_WriteData(0x01);
-
-    // Positive gamma correction
-    ILI9341_WriteCommand(ILI9341_GMCTRP1);
-    ILI9341_WriteData(0x0F);
-    ILI9341_WriteData(0x31);
-    ILI9341_WriteData(0x2B);
-    ILI9341_WriteData(0x0C);
-    ILI9341_WriteData(0x0E);
-    ILI9341_WriteData(0x08);
-    ILI9341_WriteData(0x4E);
-    ILI9341_WriteData(0xF1);
-    ILI9341_WriteData(0x37);
-    ILI9341_WriteData(0x07);
-    ILI9341_WriteData(0x10);
-    ILI9341_WriteData(0x03);
-    ILI9341_WriteData(0x0E);
-    ILI9341_WriteData(0x09);
-    ILI9341_WriteData(0x00);
-
-    // Negative gamma correction
-    ILI9341_WriteCommand(ILI9341_GMCTRN1);
-    ILI9341_WriteData(0x00);
-    ILI9341_WriteData(0x0E);
-    ILI9341_WriteData(0x14);
-    ILI9341_WriteData(0x03);
-    ILI9341_WriteData(0x11);
-    ILI9341_WriteData(0x07);
-    ILI9341_WriteData(0x31);
-    ILI9341_WriteData(0xC1);
-    ILI9341_WriteData(0x48);
-    ILI9341_WriteData(0x08);
-    ILI9341_WriteData(0x0F);
-    ILI9341_WriteData(0x0C);
-    ILI9341_WriteData(0x31);
-    ILI9341_WriteData(0x36);
-    ILI9341_WriteData(0x0F);
-
-    // Exit sleep mode
-    ILI9341_WriteCommand(ILI9341_SLPOUT);
-    HAL_Delay(120);
-
-    // Display on
-    ILI9341_WriteCommand(ILI9341_DISPON);
-    HAL_Delay(50);
+    ILI9341_WriteData(panel->pixfmt);
 
     // Fill screen with black
     ILI9341_Fill(BLACK);
 }
 
+// One fade register argument at level 0 (dim) .. 255 (lit). Gamma argument 8
+// holds two 4-bit fields (VP27/VP36, VN27/VN36), which are blended separately.
+uint8_t ILI9341_FadeArg(uint8_t cmd, uint8_t index, uint8_t lit, uint8_t dim, uint8_t level) {
+    if ((cmd == ILI9341_GMCTRP1 || cmd == ILI9341_GMCTRN1) && index == 7) {
+        return (uint8_t)((ILI9341_FadeArg(0, 0, lit >> 4, dim >> 4, level) << 4) |
+                         ILI9341_FadeArg(0, 0, lit & 0x0F, dim & 0x0F, level));
+    }
+    return (uint8_t)(dim + ((int32_t)(lit - dim) * level) / 255);
+}
+
+// Whole-screen fade through the power and gamma registers, no GRAM writes
+void ILI9341_SetFade(uint8_t level) {
+    const uint8_t *lit = ili9341_panel->fade_lit;
+    const uint8_t *dim = ili9341_panel->fade_dim;
+
+    while (*lit != ILI9341_INIT_END) {
+        uint8_t cmd = lit[0];
+        uint8_t n = lit[1] & ~ILI9341_INIT_DELAY;
+
+        ILI9341_WriteCommand(cmd);
+        for (uint8_t i = 0; i < n; i++) {
+            ILI9341_WriteData(ILI9341_FadeArg(cmd, i, lit[2 + i], dim[2 + i], level));
+        }
+        lit += 2 + n;
+        dim += 2 + n;
+    }
+}
+
+// First argument the panel's init table writes to cmd, -1 if the table does not set it
+int16_t ILI9341_InitArg(const ILI9341_Panel_t *panel, uint8_t cmd) {
+    const uint8_t *p = panel->init;
+
+    while (*p != ILI9341_INIT_END) {
+        uint8_t n = p[1];
+
+        if (p[0] == cmd && (n & ~ILI9341_INIT_DELAY)) return p[2];
+        p += 2 + (n & ~ILI9341_INIT_DELAY) + ((n & ILI9341_INIT_DELAY) ? 1 : 0);
+    }
+    return -1;
+}
+
+// rddst = the 4 RDDST bytes after the dummy read. Power-on and reset leave MADCTL at 0
+// and the pixel format at 18 bits, so a panel that reports the init table's MADCTL and
+// the descriptor's pixel format has been set up before and still holds its GRAM.
+uint8_t ILI9341_IsConfigured(const ILI9341_Panel_t *panel, const uint8_t *rddst) {
+    int16_t madctl = ILI9341_InitArg(panel, ILI9341_MADCTL);
+
+    if (madctl < 0) return 0;
+    return (rddst[0] & 0x7E) == ((madctl >> 1) & 0x7E) &&     // MY MX MV ML BGR MH
+           ((rddst[1] >> 4) & 0x07) == (panel->pixfmt & 0x07); // Interface pixel format
+}
+
+// Low-power park: display off and sleep in. GRAM and registers are kept while the
+// panel stays powered and RST stays high, so ILI9341_Resume can wake it without a redraw.
+void ILI9341_Park(void) {
+    ILI9341_WriteCommand(ILI9341_DISPOFF);
+    ILI9341_WriteCommand(ILI9341_SLPIN);
+    HAL_Delay(5);
+}
+
+// Boot path: if RDDST shows a panel that is already configured, wake it with SLPOUT
+// (and DISPON) only and return 1. Returns 0 when ILI9341_InitPanel is needed.
+uint8_t ILI9341_Resume(const ILI9341_Panel_t *panel) {
+    uint8_t st[4], mode;
+
+    RD_HIGH();
+    WR_HIGH();
+    CS_HIGH();
+    RST_HIGH();
+    ILI9341_SetDataPinsOutput();
+
+    ILI9341_ReadReg(ILI9341_RDDST, st, 4);
+    if (!ILI9341_IsConfigured(panel, st)) return 0;
+
+    ILI9341_ReadReg(ILI9341_RDMODE, &mode, 1);
+    if (!(mode & ILI9341_MODE_SLPOUT)) {
+        ILI9341_WriteCommand(ILI9341_SLPOUT);
+        HAL_Delay(5);            // Next command allowed after 5 ms
+    }
+    if (!(mode & ILI9341_MODE_DISPON)) ILI9341_WriteCommand(ILI9341_DISPON);
+
+    ili9341_panel = panel;
+    return 1;
+}
+
 void ILI9341_SetAddress(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
     ILI9341_WriteCommand(ILI9341_CASET);
     ILI9341_WriteData16(x1);
@@ -431,67 +529,120 @@ void ILI9341_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t c
     CS_HIGH();
 }
 
+// Solid span in signed coordinates: outline runs may start left of or above the screen
+static void ILI9341_Span(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if (w <= 0 || h <= 0) return;
+    ILI9341_FillRect(x, y, w, h, color);    // Clips the right and bottom edges
+}
+
+// Bresenham, but every maximal run along the major axis goes out through one window
+// (11 bytes of addressing per run instead of per pixel)
 void ILI9341_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color) {
     int16_t dx = abs(x1 - x0);
     int16_t dy = abs(y1 - y0);
     int16_t sx = (x0 < x1) ? 1 : -1;
     int16_t sy = (y0 < y1) ? 1 : -1;
     int16_t err = dx - dy;
+    int16_t x = x0, y = y0;
+    int16_t rx = x, ry = y;      // Start of the current run
+    uint8_t xmajor = (dx >= dy);
 
     while (1) {
-        ILI9341_DrawPixel(x0, y0, color);
-
-        if (x0 == x1 && y0 == y1) break;
-
-        int16_t e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
+        uint8_t last = (x == x1 && y == y1);
+        int16_t nx = x, ny = y;
+
+        if (!last) {
+            int16_t e2 = 2 * err;
+            if (e2 > -dy) {
+                err -= dy;
+                nx += sx;
+            }
+            if (e2 < dx) {
+                err += dx;
+                ny += sy;
+            }
         }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+
+        // The run ends where the minor coordinate steps
+        if (last || (xmajor ? ny != y : nx != x)) {
+            if (xmajor) ILI9341_Span((rx < x) ? rx : x, y, abs(x - rx) + 1, 1, color);
+            else ILI9341_Span(x, (ry < y) ? ry : y, 1, abs(y - ry) + 1, color);
+            rx = nx;
+            ry = ny;
         }
+        if (last) break;
+        x = nx;
+        y = ny;
     }
 }
 
+// Four spans: top and bottom rows, then the sides without the corners
 void ILI9341_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    ILI9341_DrawLine(x, y, x + w - 1, y, color);
-    ILI9341_DrawLine(x + w - 1, y, x + w - 1, y + h - 1, color);
-    ILI9341_DrawLine(x + w - 1, y + h - 1, x, y + h - 1, color);
-    ILI9341_DrawLine(x, y + h - 1, x, y, color);
+    if (w == 0 || h == 0) return;
+
+    ILI9341_Span(x, y, w, 1, color);
+    if (h > 1) ILI9341_Span(x, y + h - 1, w, 1, color);
+    if (h > 2) {
+        ILI9341_Span(x, y + 1, 1, h - 2, color);
+        if (w > 1) ILI9341_Span(x + w - 1, y + 1, 1, h - 2, color);
+    }
 }
 
+// Midpoint circle with the octants merged into runs: while y stays the same for
+// x = xs..xe, the four octants near the poles share horizontal runs and the four
+// near the equator share vertical runs (runs at x = 0 span both sides at once)
 void ILI9341_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color) {
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
     int16_t x = 0;
     int16_t y = r;
+    int16_t xs = 0;              // First x of the run at this y
 
-    ILI9341_DrawPixel(x0, y0 + r, color);
-    ILI9341_DrawPixel(x0, y0 - r, color);
-    ILI9341_DrawPixel(x0 + r, y0, color);
-    ILI9341_DrawPixel(x0 - r, y0, color);
+    while (1) {
+        uint8_t last = (x >= y);
+        int16_t ny = y;
+
+        if (!last) {
+            if (f >= 0) {
+                ny--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            ddF_x += 2;
+            f += ddF_x;
+        }
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
+        if (last || ny != y) {
+            int16_t n = x - xs + 1;
+            if (xs == 0) {
+                ILI9341_Span(x0 - x, y0 - y, 2 * x + 1, 1, color);
+                ILI9341_Span(x0 - x, y0 + y, 2 * x + 1, 1, color);
+                ILI9341_Span(x0 - y, y0 - x, 1, 2 * x + 1, color);
+                ILI9341_Span(x0 + y, y0 - x, 1, 2 * x + 1, color);
+            } else {
+                ILI9341_Span(x0 - x, y0 - y, n, 1, color);
+                ILI9341_Span(x0 + xs, y0 - y, n, 1, color);
+                ILI9341_Span(x0 - x, y0 + y, n, 1, color);
+                ILI9341_Span(x0 + xs, y0 + y, n, 1, color);
+                ILI9341_Span(x0 - y, y0 - x, 1, n, color);
+                ILI9341_Span(x0 - y, y0 + xs, 1, n, color);
+                ILI9341_Span(x0 + y, y0 - x, 1, n, color);
+                ILI9341_Span(x0 + y, y0 + xs, 1, n, color);
+            }
+            xs = x + 1;
         }
+        if (last) break;
         x++;
-        ddF_x += 2;
-        f += ddF_x;
-
-        ILI9341_DrawPixel(x0 + x, y0 + y, color);
-        ILI9341_DrawPixel(x0 - x, y0 + y, color);
-        ILI9341_DrawPixel(x0 + x, y0 - y, color);
-        ILI9341_DrawPixel(x0 - x, y0 - y, color);
-        ILI9341_DrawPixel(x0 + y, y0 + x, color);
-        ILI9341_DrawPixel(x0 - y, y0 + x, color);
-        ILI9341_DrawPixel(x0 + y, y0 - x, color);
-        ILI9341_DrawPixel(x0 - y, y0 - x, color);
+        y = ny;
     }
 }
 
@@ -526,3 +677,139 @@ void ILI9341_DrawString(uint16_t x, uint16_t y, char* str, uint16_t color, uint1
         str++;
     }
 }
+
+// Draw one character cell (glyph + spacing column) through a single window
+void ILI9341_DrawCharFast(uint16_t x, uint16_t y, char ch, uint16_t color, uint16_t bgcolor) {
+    if (x + ILI9341_CHAR_W > ILI9341_WIDTH || y + ILI9341_CHAR_H > ILI9341_HEIGHT) return;
+    if (ch < 32 || ch > 126) ch = 32;
+
+    const uint8_t *font_data = font5x7[ch - 32];
+
+    ILI9341_SetAddress(x, y, x + ILI9341_CHAR_W - 1, y + ILI9341_CHAR_H - 1);
+
+    CS_LOW();
+    RS_HIGH(); // Data mode
+
+    for (uint8_t row = 0; row < ILI9341_CHAR_H; row++) {
+        for (uint8_t col = 0; col < ILI9341_CHAR_W; col++) {
+            uint16_t c = (col < 5 && (font_data[col] & (1 << row))) ? color : bgcolor;
+            ILI9341_WriteData8(c >> 8);
+            ILI9341_WriteData8(c & 0xFF);
+        }
+    }
+
+    CS_HIGH();
+}
+
+void ILI9341_TextField_Init(ILI9341_TextField_t *tf, uint16_t x, uint16_t y, uint8_t max_len, uint16_t color, uint16_t bgcolor) {
+    if (max_len > ILI9341_TEXTFIELD_MAX) max_len = ILI9341_TEXTFIELD_MAX;
+
+    tf->x = x;
+    tf->y = y;
+    tf->color = color;
+    tf->bgcolor = bgcolor;
+    tf->max_len = max_len;
+    tf->len = 0;       // Field area is assumed to already hold bgcolor
+    tf->text[0] = '\0';
+}
+
+// Redraw only the cells whose character changed, then clear the leftover tail
+void ILI9341_TextField_Update(ILI9341_TextField_t *tf, const char *str) {
+    uint8_t len = 0;
+
+    while (len < tf->max_len && str[len] && str[len] != '\n') {
+        if (len >= tf->len || tf->text[len] != str[len]) {
+            ILI9341_DrawCharFast(tf->x + len * ILI9341_CHAR_W, tf->y, str[len], tf->color, tf->bgcolor);
+            tf->text[len] = str[len];
+        }
+        len++;
+    }
+
+    if (len < tf->len) {
+        ILI9341_FillRect(tf->x + len * ILI9341_CHAR_W, tf->y,
+                         (tf->len - len) * ILI9341_CHAR_W, ILI9341_CHAR_H, tf->bgcolor);
+    }
+
+    tf->len = len;
+    tf->text[len] = '\0';
+}
+
+// Repaint every cell, e.g. after something else drew over the field
+void ILI9341_TextField_Redraw(ILI9341_TextField_t *tf) {
+    for (uint8_t i = 0; i < tf->len; i++) {
+        ILI9341_DrawCharFast(tf->x + i * ILI9341_CHAR_W, tf->y, tf->text[i], tf->color, tf->bgcolor);
+    }
+}
+
+// Vertical scrolling definition: top fixed + scroll area + bottom fixed = panel height
+void ILI9341_SetScrollArea(uint16_t top, uint16_t height, uint16_t bottom) {
+    ILI9341_WriteCommand(ILI9341_VSCRDEF);
+    ILI9341_WriteData16(top);
+    ILI9341_WriteData16(height);
+    ILI9341_WriteData16(bottom);
+}
+
+// GRAM line shown at the top of the scroll area
+void ILI9341_SetScrollStart(uint16_t line) {
+    ILI9341_WriteCommand(ILI9341_VSCRSADD);
+    ILI9341_WriteData16(line);
+}
+
+void ILI9341_Console_Init(ILI9341_Console_t *con, uint16_t top, uint16_t height, uint16_t color, uint16_t bgcolor) {
+    if (top >= ILI9341_HEIGHT) top = ILI9341_HEIGHT - ILI9341_CHAR_H;
+    if (top + height > ILI9341_HEIGHT) height = ILI9341_HEIGHT - top;
+    height -= height % ILI9341_CHAR_H;  // Leftover rows join the bottom fixed area
+    if (height / ILI9341_CHAR_H > 255) height = 255 * ILI9341_CHAR_H;
+
+    con->top = top;
+    con->height = height;
+    con->lines = height / ILI9341_CHAR_H;
+    con->color = color;
+    con->bgcolor = bgcolor;
+
+    ILI9341_SetScrollArea(top, height, ILI9341_HEIGHT - top - height);
+    ILI9341_Console_Clear(con);
+}
+
+// Append one line: render it into the oldest slot, then move the scroll start
+void ILI9341_Console_Print(ILI9341_Console_t *con, const char *str) {
+    if (con->lines == 0) return;
+
+    uint8_t slot;
+    if (con->count < con->lines) {
+        slot = con->count++;
+    } else {
+        slot = con->head;
+        con->head = (con->head + 1) % con->lines;
+    }
+
+    uint16_t y = con->top + slot * ILI9341_CHAR_H;
+    uint16_t x = 0;
+
+    while (*str && *str != '\n' && x + ILI9341_CHAR_W <= ILI9341_WIDTH) {
+        ILI9341_DrawCharFast(x, y, *str, con->color, con->bgcolor);
+        x += ILI9341_CHAR_W;
+        str++;
+    }
+    if (x < ILI9341_WIDTH) {
+        ILI9341_FillRect(x, y, ILI9341_WIDTH - x, ILI9341_CHAR_H, con->bgcolor);
+    }
+
+    if (con->count == con->lines) {
+        ILI9341_SetScrollStart(con->top + con->head * ILI9341_CHAR_H);
+    }
+}
+
+void ILI9341_Console_Clear(ILI9341_Console_t *con) {
+    con->count = 0;
+    con->head = 0;
+    ILI9341_SetScrollStart(con->top);
+    ILI9341_FillRect(0, con->top, ILI9341_WIDTH, con->height, con->bgcolor);
+}
+
+// Leave console mode: whole panel back to a single non-scrolling area
+void ILI9341_Console_Close(ILI9341_Console_t *con) {
+    ILI9341_SetScrollArea(0, ILI9341_HEIGHT, 0);
+    ILI9341_SetScrollStart(0);
+    con->lines = 0;
+}
@@ -1,27 +1,63 @@
 /* ============================================================================
- * STM32F103 + ILI9341 LCD (240x320) - Vector Robot Eye Animation
+ * STM32F103 + ILI9341 LCD (240x320) / ILI9488 (320x480) - Vector Robot Eye Animation
  * ★★★ 초고속 버전 - GPIO 레지스터 직접 접근 ★★★
  * ============================================================================
  */
 
 #include "main.h"
+#include "ili9341.h"
+#include "eye_proto.h"
 #include <string.h>
 #include <stdlib.h>
 
+// ============================================================================
+// ★ 성능 계측 (버스 바이트 / 사이클 카운터) ★
+// ============================================================================
+
+#ifndef HUD_ENABLE
+#define HUD_ENABLE      0        // 1: 눈 영역 위쪽 띠에 프레임 통계 오버레이 표시
+#endif
+#ifndef PARK_ENABLE
+#define PARK_ENABLE     0        // 1: 웜 재개 / 대기 모드 사용 (패널 읽기 경로 포함)
+#endif
+
+static uint32_t lcd_bus_bytes = 0;   // 누적 버스 전송 바이트 (명령 + 데이터)
+static uint16_t lcd_cmd_seq = 0;     // 명령 바이트마다 증가 (쓰기 상태 소유 확인용)
+static uint16_t lcd_win_seq = 0;     // LCD_SetWindow 마다 증가 (윈도우 소유 확인용)
+
+// DWT 사이클 카운터 (64MHz → 1us = 64 cycles)
+static inline void Perf_Init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t Perf_Cycles(void) {
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t Perf_CyclesToUs(uint32_t cycles) {
+    return cycles / (SystemCoreClock / 1000000);
+}
+
 // ============================================================================
 // ★ 초고속 GPIO 매크로 (레지스터 직접 접근) ★
 // ============================================================================
 
 // Control pins (BSRR: set, BRR: reset)
+// 호스트 빌드(tools/host/main.h)는 LCD_HOST 와 함께 버스를 해독하는 매크로를 미리 정의
+#ifndef LCD_HOST
 #define LCD_CS_LOW()    GPIOB->BRR = GPIO_PIN_0
 #define LCD_CS_HIGH()   GPIOB->BSRR = GPIO_PIN_0
 #define LCD_RS_LOW()    GPIOA->BRR = GPIO_PIN_4      // Command
 #define LCD_RS_HIGH()   GPIOA->BSRR = GPIO_PIN_4     // Data
 #define LCD_WR_LOW()    GPIOA->BRR = GPIO_PIN_1
 #define LCD_WR_HIGH()   GPIOA->BSRR = GPIO_PIN_1
+#define LCD_RD_LOW()    GPIOA->BRR = GPIO_PIN_0
 #define LCD_RD_HIGH()   GPIOA->BSRR = GPIO_PIN_0
 #define LCD_RST_LOW()   GPIOC->BRR = GPIO_PIN_1
 #define LCD_RST_HIGH()  GPIOC->BSRR = GPIO_PIN_1
+#endif
 
 // ★ 8-bit 데이터 고속 출력 ★
 // D0=PA9, D1=PC7, D2=PA10, D3=PB3, D4=PB5, D5=PB4, D6=PB10, D7=PA8
@@ -60,6 +96,26 @@ static inline void LCD_Write16Fast(uint16_t color) {
     LCD_Write8Fast(color & 0xFF);
 }
 
+// ============================================================================
+// ★ 패널 선택 (해상도 / 초기화 테이블 / 픽셀 포맷은 ili9341.c 의 설명자) ★
+// ============================================================================
+// 모든 채우기 / 구간 / 블릿 경로는 LCD_W x LCD_H 로만 화면 크기를 알고, 버스 시간은
+// 패널 크기가 아니라 실제로 갱신한 면적에 비례. 레이아웃은 화면 가운데 기준
+
+#ifndef LCD_PANEL_9488
+#define LCD_PANEL_9488  0        // 1: ILI9488 320x480 (같은 8080 8-bit 버스), 0: ILI9341 240x320
+#endif
+
+#if LCD_PANEL_9488
+#define LCD_PANEL       (&ili9488_panel_320x480)
+#define LCD_W           ILI9488_PANEL_W
+#define LCD_H           ILI9488_PANEL_H
+#else
+#define LCD_PANEL       (&ili9341_panel_240x320)
+#define LCD_W           ILI9341_PANEL_W
+#define LCD_H           ILI9341_PANEL_H
+#endif
+
 // ============================================================================
 // LCD 기본 함수 (고속 버전)
 // ============================================================================
@@ -69,6 +125,8 @@ static void LCD_WriteCommand(uint8_t cmd) {
     LCD_RS_LOW();
     LCD_Write8Fast(cmd);
     LCD_CS_HIGH();
+    lcd_bus_bytes++;
+    lcd_cmd_seq++;
 }
 
 static void LCD_WriteData(uint8_t data) {
@@ -76,9 +134,57 @@ static void LCD_WriteData(uint8_t data) {
     LCD_RS_HIGH();
     LCD_Write8Fast(data);
     LCD_CS_HIGH();
+    lcd_bus_bytes++;
+}
+
+#if PARK_ENABLE
+// ★ 읽기 경로 (웜 재개의 상태 확인용, 드물게 호출) ★
+// 데이터 핀을 CRL/CRH 로 직접 전환: 입력 플로팅 0x4 / 출력 50MHz push-pull 0x3
+static void LCD_BusDir(uint8_t input) {
+    uint32_t m = input ? 0x4 : 0x3;
+    GPIOA->CRH = (GPIOA->CRH & ~0x00000FFFu) | (m * 0x00000111u);   // PA8, PA9, PA10
+    GPIOB->CRL = (GPIOB->CRL & ~0x00FFF000u) | (m * 0x00111000u);   // PB3, PB4, PB5
+    GPIOB->CRH = (GPIOB->CRH & ~0x00000F00u) | (m << 8);             // PB10
+    GPIOC->CRL = (GPIOC->CRL & ~0xF0000000u) | (m << 28);            // PC7
+}
+
+// RD 로우 구간: 레지스터 읽기 접근 시간 (최대 40ns) 보다 넉넉하게
+static uint8_t LCD_Read8(void) {
+    LCD_RD_LOW();
+    for(uint8_t i = 0; i < 8; i++) __NOP();
+    uint32_t a = GPIOA->IDR, b = GPIOB->IDR, c = GPIOC->IDR;
+    LCD_RD_HIGH();
+
+    uint8_t d = 0;
+    if(a & GPIO_PIN_9)  d |= 0x01;
+    if(c & GPIO_PIN_7)  d |= 0x02;
+    if(a & GPIO_PIN_10) d |= 0x04;
+    if(b & GPIO_PIN_3)  d |= 0x08;
+    if(b & GPIO_PIN_5)  d |= 0x10;
+    if(b & GPIO_PIN_4)  d |= 0x20;
+    if(b & GPIO_PIN_10) d |= 0x40;
+    if(a & GPIO_PIN_8)  d |= 0x80;
+    return d;
+}
+
+// 읽기 명령: 더미 1바이트 뒤 n 바이트
+static void LCD_ReadReg(uint8_t cmd, uint8_t *buf, uint8_t n) {
+    LCD_CS_LOW();
+    LCD_RS_LOW();
+    LCD_Write8Fast(cmd);
+    LCD_RS_HIGH();
+    LCD_BusDir(1);
+    (void)LCD_Read8();
+    for(uint8_t i = 0; i < n; i++) buf[i] = LCD_Read8();
+    LCD_CS_HIGH();
+    LCD_BusDir(0);
+    lcd_bus_bytes += 2 + n;
+    lcd_cmd_seq++;
 }
+#endif
 
 static void LCD_SetWindow(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
+    lcd_win_seq++;
     LCD_WriteCommand(0x2A);  // CASET
     LCD_CS_LOW();
     LCD_RS_HIGH();
@@ -96,24 +202,168 @@ static void LCD_SetWindow(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
     LCD_Write8Fast(y2 >> 8);
     LCD_Write8Fast(y2 & 0xFF);
     LCD_CS_HIGH();
+    lcd_bus_bytes += 8;
 
     LCD_WriteCommand(0x2C);  // RAMWR
 }
 
-// ★ 초고속 사각형 채우기 ★
-static void LCD_FillRectFast(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    if(x >= 240 || y >= 320 || w == 0 || h == 0) return;
-    if(x + w > 240) w = 240 - x;
-    if(y + h > 320) h = 320 - y;
+// 클립 사각형 (화면 좌표, 양끝 포함) - 모든 도형이 이 영역 밖은 그리지 않음
+// 항상 화면 안으로 잘라 두므로 도형은 클립하고 나면 화면 경계를 따로 보지 않음
+typedef struct {
+    int16_t x0, y0, x1, y1;
+} Rect_t;
 
-    LCD_SetWindow(x, y, x + w - 1, y + h - 1);
+static Rect_t lcd_clip = { 0, 0, LCD_W - 1, LCD_H - 1 };
+static int16_t lcd_ox = 0, lcd_oy = 0;   // 뷰포트 원점: 화면 좌표 = 도형 좌표 + 원점
+
+static inline void LCD_SetClip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    lcd_clip.x0 = (x0 < 0) ? 0 : x0;
+    lcd_clip.y0 = (y0 < 0) ? 0 : y0;
+    lcd_clip.x1 = (x1 > LCD_W - 1) ? LCD_W - 1 : x1;
+    lcd_clip.y1 = (y1 > LCD_H - 1) ? LCD_H - 1 : y1;
+}
+
+static inline void LCD_ResetClip(void) {
+    LCD_SetClip(0, 0, LCD_W - 1, LCD_H - 1);
+}
+
+static inline uint8_t Rect_Intersect(const Rect_t *a, const Rect_t *b, Rect_t *out) {
+    out->x0 = (a->x0 > b->x0) ? a->x0 : b->x0;
+    out->y0 = (a->y0 > b->y0) ? a->y0 : b->y0;
+    out->x1 = (a->x1 < b->x1) ? a->x1 : b->x1;
+    out->y1 = (a->y1 < b->y1) ? a->y1 : b->y1;
+    return (out->x0 <= out->x1 && out->y0 <= out->y1);
+}
+
+static inline void Rect_Union(Rect_t *a, const Rect_t *b) {
+    if(b->x0 < a->x0) a->x0 = b->x0;
+    if(b->y0 < a->y0) a->y0 = b->y0;
+    if(b->x1 > a->x1) a->x1 = b->x1;
+    if(b->y1 > a->y1) a->y1 = b->y1;
+}
+
+static inline int32_t Rect_Area(const Rect_t *r) {
+    return (int32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+// 사각형을 클립 영역과 교차 (화면 좌표, 양끝 포함), 비면 0
+static uint8_t LCD_ClipBox(int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1) {
+    if(*x0 < lcd_clip.x0) *x0 = lcd_clip.x0;
+    if(*y0 < lcd_clip.y0) *y0 = lcd_clip.y0;
+    if(*x1 > lcd_clip.x1) *x1 = lcd_clip.x1;
+    if(*y1 > lcd_clip.y1) *y1 = lcd_clip.y1;
+    return (*x0 <= *x1 && *y0 <= *y1);
+}
+
+// ★ 뷰포트 / 클립 스택 ★
+// 도형 좌표는 뷰포트 원점 기준 (음수 가능) → 화면 밖에서 밀려 들어오는 장면도 좌표만 옮겨 그림
+// 넣을 때마다 현재 클립과 교차하므로 안쪽 뷰포트는 바깥 영역을 넘지 못함
+// 도형은 시작할 때 경계 상자로 한 번 판정 (LCD_Visible): 완전히 밖이면 래스터화 없이 반환,
+// 걸치면 구간 (행 / 사각형) 단위로 한 번 자름
+// 컴포지터 / 타일 / 구간 캐시는 화면 좌표로 동작 → 뷰포트는 렌더러 안에서 잠깐 쓰고 꺼냄
+
+#define VIEW_DEPTH      4
+
+typedef struct {
+    Rect_t clip;
+    int16_t ox, oy;
+} View_t;
+
+static View_t view_stack[VIEW_DEPTH];
+static uint8_t view_depth = 0;
+
+// 현재 뷰포트 좌표의 (x, y, w, h) 영역을 새 뷰포트로 (원점 이동 + 클립 교차), 스택이 차면 0
+static uint8_t LCD_PushView(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if(view_depth >= VIEW_DEPTH) return 0;
+
+    View_t *v = &view_stack[view_depth++];
+    v->clip = lcd_clip;
+    v->ox = lcd_ox;
+    v->oy = lcd_oy;
+
+    lcd_ox += x;
+    lcd_oy += y;
+    Rect_t r = { lcd_ox, lcd_oy, lcd_ox + w - 1, lcd_oy + h - 1 };
+    if(!Rect_Intersect(&v->clip, &r, &lcd_clip)) lcd_clip.x1 = lcd_clip.x0 - 1;   // 빈 클립
+    return 1;
+}
+
+// 원점은 그대로 두고 클립만 좁힘 (뷰포트 좌표)
+static uint8_t LCD_PushClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if(!LCD_PushView(x, y, w, h)) return 0;
+    lcd_ox -= x;
+    lcd_oy -= y;
+    return 1;
+}
+
+static void LCD_PopView(void) {
+    if(view_depth == 0) return;
+    View_t *v = &view_stack[--view_depth];
+    lcd_clip = v->clip;
+    lcd_ox = v->ox;
+    lcd_oy = v->oy;
+}
+
+// 뷰포트 좌표 경계 상자 (양끝 포함) 가 클립과 겹치는지
+static inline uint8_t LCD_Visible(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    return x0 + lcd_ox <= lcd_clip.x1 && x1 + lcd_ox >= lcd_clip.x0 &&
+           y0 + lcd_oy <= lcd_clip.y1 && y1 + lcd_oy >= lcd_clip.y0;
+}
+
+// 단색 구간 (기록은 클립 후 화면 좌표, LCD_DrawSpans 는 뷰포트 좌표로 받음)
+typedef struct {
+    int16_t x, y;
+    uint8_t w, h;
+    uint16_t color;
+} Span_t;
+
+typedef struct {
+    Span_t *buf;
+    uint16_t n, cap;
+    uint8_t overflow;
+    void (*sink)(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);  // 있으면 저장 대신 호출
+} SpanList_t;
+
+static SpanList_t *span_rec = NULL;   // 기록 중이면 버스 대신 여기에 쌓음
+
+static void Span_Record(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    SpanList_t *l = span_rec;
+    if(l->sink) { l->sink(x, y, w, h, color); return; }
+
+    // 같은 색 직전 구간 중 같은 행에서 겹치거나 맞닿으면 합침 (원 채우기의 중복 행 제거)
+    if(h == 1) {
+        for(int16_t i = l->n - 1; i >= 0 && i >= (int16_t)l->n - 4; i--) {
+            Span_t *p = &l->buf[i];
+            if(p->color != color) break;
+            if(p->h == 1 && p->y == y && x <= p->x + p->w && p->x <= x + w) {
+                int16_t end = (p->x + p->w > x + w) ? (p->x + p->w) : (x + w);
+                int16_t start = (x < p->x) ? x : p->x;
+                if(end - start > 255) break;
+                p->x = start;
+                p->w = end - start;
+                return;
+            }
+        }
+    }
+
+    // w / h 는 8비트 → 넓은 패널 (320) 의 전폭 구간은 나눠서 저장
+    for(int16_t xx = x; xx < x + w; xx += 255) {
+        int16_t ww = (x + w - xx > 255) ? 255 : (x + w - xx);
+        for(int16_t yy = y; yy < y + h; yy += 255) {
+            if(l->n >= l->cap) { l->overflow = 1; return; }
+            Span_t *sp = &l->buf[l->n++];
+            sp->x = xx; sp->y = yy; sp->w = ww;
+            sp->h = (y + h - yy > 255) ? 255 : (y + h - yy);
+            sp->color = color;
+        }
+    }
+}
 
-    uint32_t total = (uint32_t)w * h;
+// 단색 total 픽셀 (CS LOW / RS HIGH 상태에서, 일괄 그리기는 CS 를 잡은 채 여러 번 호출)
+static inline void LCD_StreamPixels(uint32_t total, uint16_t color) {
     uint8_t hi = color >> 8;
     uint8_t lo = color & 0xFF;
-
-    LCD_CS_LOW();
-    LCD_RS_HIGH();
+    lcd_bus_bytes += total * 2;
 
     // ★ 언롤링으로 더 빠르게 ★
     while(total >= 8) {
@@ -131,21 +381,47 @@ static void LCD_FillRectFast(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uin
         LCD_Write8Fast(hi);
         LCD_Write8Fast(lo);
     }
+}
 
+// 단색 total 픽셀 연속 전송 (윈도우 / RAMWR 는 호출자가 이미 보냄)
+static void LCD_StreamColor(uint32_t total, uint16_t color) {
+    LCD_CS_LOW();
+    LCD_RS_HIGH();
+    LCD_StreamPixels(total, color);
     LCD_CS_HIGH();
 }
 
+// ★ 초고속 사각형 채우기 ★
+static void LCD_FillRectFast(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if(w <= 0 || h <= 0) return;
+    x += lcd_ox;
+    y += lcd_oy;
+
+    int16_t x1 = x + w - 1, y1 = y + h - 1;
+    if(!LCD_ClipBox(&x, &y, &x1, &y1)) return;
+    w = x1 - x + 1;
+    h = y1 - y + 1;
+    if(span_rec) { Span_Record(x, y, w, h, color); return; }
+
+    LCD_SetWindow(x, y, x + w - 1, y + h - 1);
+    LCD_StreamColor((uint32_t)w * h, color);
+}
+
 // ★ 수평선 (가장 빠른 요소) ★
 static inline void LCD_HLineFast(int16_t x, int16_t y, int16_t w, uint16_t color) {
-    if(y < 0 || y >= 320 || w <= 0) return;
-    if(x < 0) { w += x; x = 0; }
-    if(x + w > 240) w = 240 - x;
+    x += lcd_ox;
+    y += lcd_oy;
+    if(y < lcd_clip.y0 || y > lcd_clip.y1 || w <= 0) return;
+    if(x < lcd_clip.x0) { w -= lcd_clip.x0 - x; x = lcd_clip.x0; }
+    if(x + w > lcd_clip.x1 + 1) w = lcd_clip.x1 + 1 - x;
     if(w <= 0) return;
+    if(span_rec) { Span_Record(x, y, w, 1, color); return; }
 
     LCD_SetWindow(x, y, x + w - 1, y);
 
     uint8_t hi = color >> 8;
     uint8_t lo = color & 0xFF;
+    lcd_bus_bytes += (uint32_t)w * 2;
 
     LCD_CS_LOW();
     LCD_RS_HIGH();
@@ -156,19 +432,248 @@ static inline void LCD_HLineFast(int16_t x, int16_t y, int16_t w, uint16_t color
     LCD_CS_HIGH();
 }
 
+// ============================================================================
+// ★ 일괄 그리기 (사각형 / 구간 배열을 호출 한 번에) ★
+// ============================================================================
+// 항목마다 함수 진입 / CS 토글 / 윈도우 11바이트를 따로 내던 것을 배열 하나로 묶음
+//   - CS 는 배치 내내 LOW, 명령과 데이터는 RS 로만 구분
+//   - 윈도우 행은 항목 시작 행부터 화면 끝까지 열어 둠 → 바뀐 축만 다시 보냄:
+//     같은 열에서 바로 아래 행으로 이어지면 0바이트, 같은 열이면 PASET 만,
+//     같은 시작 행이면 CASET 만 (+ RAMWR 1바이트)
+//   - 뷰포트 평행이동 / 클립은 루프 안에서 항목마다 비교 4번, 밖인 항목은 건너뜀
+//   - 기록 중 (span_rec) 이면 잘린 항목을 기록 쪽으로 (타일 해시 / 구간 캐시)
+// 항목 순서대로 그리므로 겹치는 항목의 결과는 따로 그릴 때와 같음
+
+typedef struct {
+    int16_t x0, x1, y0;          // 패널 윈도우 (행 y0 ~ LCD_H-1), x0 > x1 이면 아직 없음
+    int16_t y;                   // 같은 열로 이어 쓸 다음 행
+} Batch_t;
+
+static void Batch_Begin(Batch_t *b) {
+    b->x0 = 1; b->x1 = 0;
+    b->y0 = b->y = -1;
+    lcd_win_seq++;               // 분할 채우기가 이 윈도우에 RAMWRC 로 이어 쓰지 않게
+    LCD_CS_LOW();
+    LCD_RS_HIGH();
+}
+
+static inline void Batch_End(void) {
+    LCD_CS_HIGH();
+}
+
+// 주소 명령 + 16비트 인자 2개 (CS LOW 유지)
+static void Batch_Addr(uint8_t cmd, int16_t a, int16_t b) {
+    LCD_RS_LOW();
+    LCD_Write8Fast(cmd);
+    LCD_RS_HIGH();
+    LCD_Write8Fast(a >> 8);
+    LCD_Write8Fast(a & 0xFF);
+    LCD_Write8Fast(b >> 8);
+    LCD_Write8Fast(b & 0xFF);
+    lcd_bus_bytes += 5;
+    lcd_cmd_seq++;
+}
+
+// 다음 픽셀이 클립된 화면 사각형 (x0, y0) ~ (x1, y1) 에 행 순서로 들어가게
+static void Batch_Window(Batch_t *b, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if(x0 == b->x0 && x1 == b->x1 && y0 == b->y) { b->y = y1 + 1; return; }
+
+    if(x0 != b->x0 || x1 != b->x1) {
+        Batch_Addr(0x2A, x0, x1);    // CASET
+        b->x0 = x0;
+        b->x1 = x1;
+    }
+    if(y0 != b->y0) {
+        Batch_Addr(0x2B, y0, LCD_H - 1);   // PASET
+        b->y0 = y0;
+    }
+    LCD_RS_LOW();
+    LCD_Write8Fast(0x2C);        // RAMWR
+    LCD_RS_HIGH();
+    lcd_bus_bytes++;
+    lcd_cmd_seq++;
+    b->y = y1 + 1;
+}
+
+// 같은 색 사각형 n 개 (뷰포트 좌표, 양끝 포함)
+static void LCD_FillRects(const Rect_t *r, uint16_t n, uint16_t color) {
+    Batch_t b;
+    uint8_t open = 0;
+
+    for(; n; n--, r++) {
+        int16_t x0 = r->x0 + lcd_ox, y0 = r->y0 + lcd_oy;
+        int16_t x1 = r->x1 + lcd_ox, y1 = r->y1 + lcd_oy;
+        if(!LCD_ClipBox(&x0, &y0, &x1, &y1)) continue;
+        if(span_rec) { Span_Record(x0, y0, x1 - x0 + 1, y1 - y0 + 1, color); continue; }
+
+        if(!open) { Batch_Begin(&b); open = 1; }
+        Batch_Window(&b, x0, y0, x1, y1);
+        LCD_StreamPixels((uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1), color);
+    }
+    if(open) Batch_End();
+}
+
+// 구간 n 개를 (mirror 이면 mx 기준 좌우반전 후) dx, dy 평행이동해서 (뷰포트 좌표)
+static void LCD_DrawSpans(const Span_t *sp, uint16_t n, int16_t dx, int16_t dy, uint8_t mirror, int16_t mx) {
+    Batch_t b;
+    uint8_t open = 0;
+
+    dx += lcd_ox;
+    dy += lcd_oy;
+    for(; n; n--, sp++) {
+        int16_t x0 = (mirror ? (mx - (sp->x + sp->w - 1)) : sp->x) + dx;
+        int16_t y0 = sp->y + dy;
+        int16_t x1 = x0 + sp->w - 1, y1 = y0 + sp->h - 1;
+        if(!LCD_ClipBox(&x0, &y0, &x1, &y1)) continue;
+        if(span_rec) { Span_Record(x0, y0, x1 - x0 + 1, y1 - y0 + 1, sp->color); continue; }
+
+        if(!open) { Batch_Begin(&b); open = 1; }
+        Batch_Window(&b, x0, y0, x1, y1);
+        LCD_StreamPixels((uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1), sp->color);
+    }
+    if(open) Batch_End();
+}
+
+// ============================================================================
+// ★ 분할 채우기 (재개 가능, 슬라이스당 사이클 예산) ★
+// ============================================================================
+// 큰 채우기를 슬라이스로 잘라 그 사이에 lcd_poll 을 실행 → 메인 루프 최악 지연이 픽셀 수가 아니라
+// 슬라이스 예산으로 묶임. 재개할 때 윈도우가 그대로면 CASET/PASET 없이 이어 씀:
+//   아무 명령도 안 끼었으면 0바이트, 다른 명령만 끼었으면 RAMWRC(0x3C) 1바이트,
+//   다른 그리기가 윈도우를 가져갔으면 남은 영역으로 윈도우를 다시 잡음
+
+#define CHUNK_SLICE_US      500      // 기본 슬라이스 예산
+#define CHUNK_BLOCK_PX      32       // 예산 확인 간격 (픽셀, 64바이트)
+
+typedef struct {
+    int16_t x, y, w, h;          // 클립된 사각형
+    uint16_t color;
+    uint32_t done;               // 보낸 픽셀 수
+    uint16_t cmd_seq;            // 마지막 슬라이스가 끝난 시점의 lcd_cmd_seq
+    uint16_t win_seq;            // 이 채우기가 잡은 윈도우의 lcd_win_seq
+    uint8_t active;
+} Chunk_t;
+
+typedef struct {
+    uint32_t slices;
+    uint32_t continues;          // 그대로 이어 씀 (0바이트)
+    uint32_t resumes;            // RAMWRC 로 이어 씀
+    uint32_t rewindows;          // 윈도우 다시 잡음
+    uint32_t max_slice_us;       // 가장 길었던 슬라이스 = 채우기로 인한 최악 루프 지연
+} ChunkStats_t;
+
+static uint32_t chunk_slice_us = CHUNK_SLICE_US;
+static void (*lcd_poll)(void) = NULL;   // 슬라이스 사이 폴링 작업 (명령만, 그리기 금지)
+static ChunkStats_t chunk_stats;
+
+static inline uint32_t Chunk_Total(const Chunk_t *c) {
+    return (uint32_t)c->w * c->h;
+}
+
+// 남은 영역으로 윈도우를 다시 잡음 (행 중간이면 그 행의 나머지를 먼저 채움)
+static void Chunk_Window(Chunk_t *c) {
+    int16_t row = c->y + c->done / c->w;
+    int16_t col = c->done % c->w;
+
+    if(col) {
+        LCD_SetWindow(c->x + col, row, c->x + c->w - 1, row);
+        LCD_StreamColor(c->w - col, c->color);
+        c->done += c->w - col;
+        row++;
+        if(c->done >= Chunk_Total(c)) return;
+    }
+    LCD_SetWindow(c->x, row, c->x + c->w - 1, c->y + c->h - 1);
+    c->win_seq = lcd_win_seq;
+}
+
+// 클립 후 시작 준비 (버스는 아직 안 씀), 그릴 것이 없으면 0
+static uint8_t Chunk_Begin(Chunk_t *c, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t x1 = x + w - 1, y1 = y + h - 1;
+
+    c->active = 0;
+    if(w <= 0 || h <= 0) return 0;
+    x += lcd_ox; x1 += lcd_ox;
+    y += lcd_oy; y1 += lcd_oy;
+    if(!LCD_ClipBox(&x, &y, &x1, &y1)) return 0;
+    if(span_rec) { Span_Record(x, y, x1 - x + 1, y1 - y + 1, color); return 0; }
+
+    c->x = x; c->y = y;
+    c->w = x1 - x + 1; c->h = y1 - y + 1;
+    c->color = color;
+    c->done = 0;
+    c->win_seq = lcd_win_seq - 1;    // 아직 윈도우 없음
+    c->cmd_seq = lcd_cmd_seq;
+    c->active = 1;
+    return 1;
+}
+
+// 예산(사이클)만큼 전송, 남았으면 1
+static uint8_t Chunk_Step(Chunk_t *c, uint32_t budget) {
+    if(!c->active) return 0;
+
+    uint32_t t0 = Perf_Cycles();
+    uint32_t total = Chunk_Total(c);
+
+    if(c->win_seq != lcd_win_seq) {
+        if(c->done) chunk_stats.rewindows++;
+        Chunk_Window(c);
+    } else if(c->cmd_seq != lcd_cmd_seq) {
+        LCD_WriteCommand(0x3C);      // RAMWRC: 마지막으로 쓴 다음 위치부터
+        chunk_stats.resumes++;
+    } else {
+        chunk_stats.continues++;
+    }
+
+    while(c->done < total) {
+        uint32_t n = total - c->done;
+        if(n > CHUNK_BLOCK_PX) n = CHUNK_BLOCK_PX;
+        LCD_StreamColor(n, c->color);
+        c->done += n;
+        if(Perf_Cycles() - t0 >= budget) break;
+    }
+    c->cmd_seq = lcd_cmd_seq;
+
+    uint32_t us = Perf_CyclesToUs(Perf_Cycles() - t0);
+    if(us > chunk_stats.max_slice_us) chunk_stats.max_slice_us = us;
+    chunk_stats.slices++;
+
+    c->active = (c->done < total);
+    return c->active;
+}
+
+// 슬라이스 예산 설정 (us)
+static void Chunk_SetBudget(uint32_t us) {
+    chunk_slice_us = us ? us : 1;
+}
+
+// 끝까지 채우되 슬라이스 사이마다 lcd_poll 실행
+static void LCD_FillRectSliced(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    Chunk_t c;
+    uint32_t budget = chunk_slice_us * (SystemCoreClock / 1000000);
+
+    if(!Chunk_Begin(&c, x, y, w, h, color)) return;
+    while(Chunk_Step(&c, budget)) {
+        if(lcd_poll) lcd_poll();
+    }
+}
+
 // ============================================================================
 // 전체 화면 채우기
 // ============================================================================
 
 static void LCD_Fill(uint16_t color) {
-    LCD_FillRectFast(0, 0, 240, 320, color);
+    LCD_FillRectSliced(0, 0, LCD_W, LCD_H, color);
 }
 
 // ============================================================================
 // LCD 초기화
 // ============================================================================
 
+static uint8_t fade_level = 255;     // LCD_SetFade: 0 = 어두움 세트, 255 = 초기화 값
+
 static void LCD_Init(void) {
+    const uint8_t *p = LCD_PANEL->init;
+
     LCD_RD_HIGH();
     LCD_CS_HIGH();
 
@@ -177,89 +682,122 @@ static void LCD_Init(void) {
     LCD_RST_HIGH();
     HAL_Delay(50);
 
-    LCD_WriteCommand(0x01);  // Software Reset
-    HAL_Delay(100);
+    // 패널 초기화 테이블: cmd, 인자 수 (| 지연), 인자..., (지연 ms)
+    while(*p != ILI9341_INIT_END) {
+        uint8_t cmd = *p++;
+        uint8_t n = *p++;
 
-    LCD_WriteCommand(0x11);  // Sleep Out
-    HAL_Delay(120);
-
-    LCD_WriteCommand(0xCF);
-    LCD_WriteData(0x00); LCD_WriteData(0xC1); LCD_WriteData(0x30);
-
-    LCD_WriteCommand(0xED);
-    LCD_WriteData(0x64); LCD_WriteData(0x03); LCD_WriteData(0x12); LCD_WriteData(0x81);
-
-    LCD_WriteCommand(0xE8);
-    LCD_WriteData(0x85); LCD_WriteData(0x00); LCD_WriteData(0x78);
+        LCD_WriteCommand(cmd);
+        for(uint8_t i = 0; i < (n & ~ILI9341_INIT_DELAY); i++) LCD_WriteData(*p++);
+        if(n & ILI9341_INIT_DELAY) HAL_Delay(*p++);
+    }
 
-    LCD_WriteCommand(0xCB);
-    LCD_WriteData(0x39); LCD_WriteData(0x2C); LCD_WriteData(0x00);
-    LCD_WriteData(0x34); LCD_WriteData(0x02);
+    LCD_WriteCommand(0x3A);  // Pixel Format
+    LCD_WriteData(LCD_PANEL->pixfmt);
+    ili9341_panel = LCD_PANEL;
+    fade_level = 255;            // 초기화 테이블 = 밝음 세트
+}
 
-    LCD_WriteCommand(0xF7);
-    LCD_WriteData(0x20);
+// ★ 웜 재개: 부팅 시 RDDST / RDMODE 로 패널 상태 확인 ★
+// SLPIN 으로 쉬던 (또는 MCU 만 리셋된) 패널은 레지스터와 GRAM 이 그대로 → 리셋 / 초기화 /
+// 화면 지우기 없이 SLPOUT 만 보내면 마지막 얼굴이 바로 보임. 반환: 1 = 웜, 0 = LCD_Init 필요
+// MCU 가 대기 / 리셋 중일 때 RST 가 뜨지 않아야 함 (모듈의 풀업 또는 외부 풀업)
+// 초기화 테이블을 바꿔 새로 올린 펌웨어는 패널 전원을 한 번 껐다 켜야 새 값이 들어감
+// 스위치 (PARK_ENABLE) 는 파일 맨 위 (읽기 경로도 같이 빠짐)
 
-    LCD_WriteCommand(0xEA);
-    LCD_WriteData(0x00); LCD_WriteData(0x00);
+#define PARK_IDLE_MS    60000    // 명령 없이 이만큼 지나면 대기 (데모 모드는 부팅부터, 0: 대기 안 함)
 
-    LCD_WriteCommand(0xC0);  // Power Control 1
-    LCD_WriteData(0x23);
+#if PARK_ENABLE
+static uint8_t LCD_Resume(void) {
+    uint8_t st[4], mode;
 
-    LCD_WriteCommand(0xC1);  // Power Control 2
-    LCD_WriteData(0x10);
+    LCD_RD_HIGH();
+    LCD_CS_HIGH();
+    LCD_RST_HIGH();
 
-    LCD_WriteCommand(0xC5);  // VCOM Control 1
-    LCD_WriteData(0x3E); LCD_WriteData(0x28);
+    LCD_ReadReg(0x09, st, 4);    // RDDST: MADCTL / 픽셀 포맷이 초기화 값이어야 설정된 패널
+    if(!ILI9341_IsConfigured(LCD_PANEL, st)) return 0;
 
-    LCD_WriteCommand(0xC7);  // VCOM Control 2
-    LCD_WriteData(0x86);
+    LCD_ReadReg(0x0A, &mode, 1); // RDMODE: 잠자기 / 표시 상태
+    if(!(mode & ILI9341_MODE_SLPOUT)) {
+        LCD_WriteCommand(0x11);  // SLPOUT
+        HAL_Delay(5);            // 다음 명령까지 5ms
+    }
+    if(!(mode & ILI9341_MODE_DISPON)) LCD_WriteCommand(0x29);   // DISPON
 
-    LCD_WriteCommand(0x36);  // Memory Access Control
-    LCD_WriteData(0x48);
+    ili9341_panel = LCD_PANEL;
+    return 1;
+}
 
-    LCD_WriteCommand(0x3A);  // Pixel Format
-    LCD_WriteData(0x55);     // 16-bit
+#if PARK_IDLE_MS
+// 저전력 대기: 표시 끔 + SLPIN (GRAM / 레지스터 유지, SLPOUT 후 5ms 이상 지나야 함)
+static void LCD_Park(void) {
+    LCD_WriteCommand(0x28);      // DISPOFF
+    LCD_WriteCommand(0x10);      // SLPIN
+    HAL_Delay(5);
+}
+#endif
+#endif
+
+// 밝기 (WRDISBV / WRCTRLD) - 패널의 CABC PWM 출력으로 백라이트를 구동하는 모듈에서만 효과
+static void LCD_SetBrightness(uint8_t level) {
+    LCD_WriteCommand(0x51);  // Write Display Brightness
+    LCD_WriteData(level);
+    LCD_WriteCommand(0x53);  // Write CTRL Display: BCTRL + BL
+    LCD_WriteData(0x24);
+}
 
-    LCD_WriteCommand(0xB1);  // Frame Rate Control
-    LCD_WriteData(0x00); LCD_WriteData(0x18);
+// ============================================================================
+// ★ 감마 / 전원 레지스터 페이드 (GRAM 쓰기 없음) ★
+// ============================================================================
+// 패널 설명자의 밝음(초기화 값) / 어두움 레지스터 세트를 보간해 명령만 보냄
+// 단계당 ILI9341 기준 37바이트 (PWCTR1 + VMCTR1 + 양/음 감마), 화면 내용과 타일 해시는 그대로
+// → 페이드 중에도 평소처럼 그릴 수 있고, 백라이트 배선과 무관하게 동작
 
-    LCD_WriteCommand(0xB6);  // Display Function Control
-    LCD_WriteData(0x08); LCD_WriteData(0x82); LCD_WriteData(0x27);
+#define FADE_STEP_MS    16       // Fade_To 단계 간격
+#define FADE_SLEEP      48       // 졸림 / 대기 밝기
 
-    LCD_WriteCommand(0xF2);  // Gamma Function Disable
-    LCD_WriteData(0x00);
+static void LCD_SetFade(uint8_t level) {
+    const uint8_t *lit = LCD_PANEL->fade_lit;
+    const uint8_t *dim = LCD_PANEL->fade_dim;
 
-    LCD_WriteCommand(0x26);  // Gamma Curve
-    LCD_WriteData(0x01);
+    if(level == fade_level) return;
+    fade_level = level;
 
-    LCD_WriteCommand(0xE0);  // Positive Gamma
-    LCD_WriteData(0x0F); LCD_WriteData(0x31); LCD_WriteData(0x2B); LCD_WriteData(0x0C);
-    LCD_WriteData(0x0E); LCD_WriteData(0x08); LCD_WriteData(0x4E); LCD_WriteData(0xF1);
-    LCD_WriteData(0x37); LCD_WriteData(0x07); LCD_WriteData(0x10); LCD_WriteData(0x03);
-    LCD_WriteData(0x0E); LCD_WriteData(0x09); LCD_WriteData(0x00);
+    while(*lit != ILI9341_INIT_END) {
+        uint8_t cmd = lit[0];
+        uint8_t n = lit[1] & ~ILI9341_INIT_DELAY;
 
-    LCD_WriteCommand(0xE1);  // Negative Gamma
-    LCD_WriteData(0x00); LCD_WriteData(0x0E); LCD_WriteData(0x14); LCD_WriteData(0x03);
-    LCD_WriteData(0x11); LCD_WriteData(0x07); LCD_WriteData(0x31); LCD_WriteData(0xC1);
-    LCD_WriteData(0x48); LCD_WriteData(0x08); LCD_WriteData(0x0F); LCD_WriteData(0x0C);
-    LCD_WriteData(0x31); LCD_WriteData(0x36); LCD_WriteData(0x0F);
+        LCD_WriteCommand(cmd);
+        for(uint8_t i = 0; i < n; i++) LCD_WriteData(ILI9341_FadeArg(cmd, i, lit[2 + i], dim[2 + i], level));
+        lit += 2 + n;
+        dim += 2 + n;
+    }
+}
 
-    LCD_WriteCommand(0x11);  // Sleep Out
-    HAL_Delay(120);
+// ms 동안 선형으로 level 까지 (FADE_STEP_MS 마다 한 단계)
+static void Fade_To(uint8_t level, uint16_t ms) {
+    int16_t from = fade_level;
+    uint16_t steps = ms / FADE_STEP_MS;
 
-    LCD_WriteCommand(0x29);  // Display On
-    HAL_Delay(50);
+    for(uint16_t i = 1; i <= steps; i++) {
+        uint32_t t0 = HAL_GetTick();
+        LCD_SetFade((uint8_t)(from + ((int32_t)level - from) * i / steps));
+        while(HAL_GetTick() - t0 < FADE_STEP_MS) {}
+    }
+    LCD_SetFade(level);
 }
 
 // ============================================================================
 // 눈 설정
 // ============================================================================
 
-#define EYE_AREA_X      10
-#define EYE_AREA_Y      80
 #define EYE_AREA_W      220
 #define EYE_AREA_H      160
+#define EYE_AREA_X      ((LCD_W - EYE_AREA_W) / 2)
+#define EYE_AREA_Y      ((LCD_H - EYE_AREA_H) / 2)
 
+// 기본값 (실행 중에는 eye 구조체가 실제 값, Eye_SetParams 로 변경)
 #define LX              55
 #define RX              165
 #define CY              80
@@ -273,6 +811,42 @@ static void LCD_Init(void) {
 #define EYE_DIM         0x0320
 #define EYE_BG          0x0000   // BLACK
 
+#define EYE_R_MAX       32       // 모서리 반지름 상한 (스프라이트 배경 테이블 크기)
+#define EYE_GAZE_MAX    8        // 시선 (하이라이트) 이동 한계, 눈 띠 여유에 포함
+
+// 눈 모양 파라미터 (모두 16비트 → 패딩 없음, 바이트 단위 해시 가능)
+typedef struct {
+    int16_t lx, rx, cy;              // 눈 중심 (EYE_AREA 기준)
+    int16_t w, h, r;                 // 몸체 크기, 모서리 반지름
+    int16_t glint_x, glint_y, glint_r;   // 하이라이트 중심 (몸체 왼쪽 위 기준), 반지름
+    uint16_t color, bright, dim;
+} EyeParams_t;
+
+#define EYE_PARAMS_DEFAULT \
+    { LX, RX, CY, EYE_W, EYE_H, EYE_R, 8, 10, 5, EYE_COLOR, EYE_BRIGHT, EYE_DIM }
+
+static const EyeParams_t eye_default = EYE_PARAMS_DEFAULT;
+static EyeParams_t eye = EYE_PARAMS_DEFAULT;
+static uint32_t eye_hash = 0;    // 구간 캐시 키 (0 = 기본값)
+
+// FNV-1a
+static uint32_t Eye_Hash(const EyeParams_t *p) {
+    const uint8_t *b = (const uint8_t *)p;
+    uint32_t h = 2166136261u;
+    for(uint16_t i = 0; i < sizeof(*p); i++) {
+        h ^= b[i];
+        h *= 16777619u;
+    }
+    return h ? h : 1;
+}
+
+// 모든 표정이 차지하는 눈 중심 기준 가로 반폭 (EXPR_SURPRISED 원, EXPR_ANGRY 눈썹)
+static int16_t Eye_HalfSpan(const EyeParams_t *p) {
+    int16_t a = p->h/2 + 5;
+    int16_t b = p->w/2 + EYE_GAZE_MAX;
+    return (a > b) ? a : b;
+}
+
 typedef enum {
     EXPR_NORMAL, EXPR_HAPPY, EXPR_SAD, EXPR_ANGRY,
     EXPR_SURPRISED, EXPR_SLEEPY, EXPR_WINK_LEFT, EXPR_WINK_RIGHT,
@@ -290,6 +864,8 @@ static uint32_t last_action = 0;
 
 // 채워진 원 (수평선 기반)
 static void LCD_FillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if(!LCD_Visible(x0 - r, y0 - r, x0 + r, y0 + r)) return;
+
     int16_t x = r, y = 0;
     int16_t err = 1 - r;
 
@@ -305,8 +881,25 @@ static void LCD_FillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
     }
 }
 
+// LCD_FillCircle 의 중점 알고리즘을 그대로 따라 행별 반폭 계산
+static void Circle_HalfWidths(int16_t r, uint8_t *hw) {
+    int16_t x = r, y = 0;
+    int16_t err = 1 - r;
+
+    memset(hw, 0, r + 1);
+    while(x >= y) {
+        if(hw[y] < x) hw[y] = x;
+        if(hw[x] < y) hw[x] = y;
+
+        y++;
+        if(err < 0) err += 2 * y + 1;
+        else { x--; err += 2 * (y - x + 1); }
+    }
+}
+
 // 둥근 사각형
 static void LCD_RoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
+    if(w <= 0 || h <= 0 || !LCD_Visible(x, y, x + w - 1, y + h - 1)) return;
     if(w > 2*r) LCD_FillRectFast(x + r, y, w - 2*r, h, color);
     if(h > 2*r) {
         LCD_FillRectFast(x, y + r, r, h - 2*r, color);
@@ -322,6 +915,8 @@ static void LCD_RoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
 static void LCD_ThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t t, uint16_t color) {
     int16_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
     int16_t dy = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+    int16_t bx0 = ((x0 < x1) ? x0 : x1) - t/2, by0 = ((y0 < y1) ? y0 : y1) - t/2;
+    if(!LCD_Visible(bx0, by0, bx0 + dx + t, by0 + dy + t)) return;
 
     if(dy <= 2) {
         int16_t minX = (x0 < x1) ? x0 : x1;
@@ -349,206 +944,2186 @@ static void LCD_ThickLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_
     }
 }
 
+// 5x7 글자 n 개를 가로로 이어서 (6x8 셀, 윈도우 1회 + 행마다 모든 글자 연속 전송)
+#define GLYPH_W         6
+#define GLYPH_H         8
+
+static void LCD_DrawText(int16_t x, int16_t y, const char *s, uint8_t n, uint16_t fg, uint16_t bg) {
+    if(n == 0) return;
+    x += lcd_ox;
+    y += lcd_oy;
+    int16_t x0 = x, y0 = y, x1 = x + n * GLYPH_W - 1, y1 = y + GLYPH_H - 1;
+    if(!LCD_ClipBox(&x0, &y0, &x1, &y1)) return;     // 걸치면 보이는 부분만 윈도우로
+
+    uint8_t c0 = (x0 - x) / GLYPH_W, c1 = (x1 - x) / GLYPH_W;
+    LCD_SetWindow(x0, y0, x1, y1);
+
+    LCD_CS_LOW();
+    LCD_RS_HIGH();
+    for(uint8_t row = y0 - y; row <= y1 - y; row++) {
+        uint8_t mask = 1 << row;
+        for(uint8_t c = c0; c <= c1; c++) {
+            char ch = s[c];
+            if(ch < 32 || ch > 126) ch = ' ';
+            const uint8_t *g = font5x7[ch - 32];
+            uint8_t a = (c == c0) ? (x0 - x) - c * GLYPH_W : 0;
+            uint8_t b = (c == c1) ? (x1 - x) - c * GLYPH_W : GLYPH_W - 1;
+            for(uint8_t col = a; col <= b; col++) {
+                LCD_Write16Fast((col < 5 && (g[col] & mask)) ? fg : bg);
+            }
+        }
+    }
+    LCD_CS_HIGH();
+    lcd_bus_bytes += (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1) * 2;
+}
+
 // ============================================================================
-// 눈 그리기
+// ★ 사전 인코딩 버스 워드 에셋 (디코딩 없는 최고속 블릿) ★
 // ============================================================================
-
-static void Eye_Clear(void) {
-    LCD_FillRectFast(EYE_AREA_X, EYE_AREA_Y, EYE_AREA_W, EYE_AREA_H, EYE_BG);
+// 바이트마다 GPIOA / GPIOB / GPIOC BSRR 값을 미리 계산해 둔 형식 (tools/busenc.c 로 생성)
+// GPIOA 워드에는 WR(PA1) LOW 가 포함되어 있어 루프는 store, store, store, strobe
+// 픽셀당 워드 6개 = 24바이트 플래시 (RGB565 의 12배) → 자주 쓰는 작은 에셋에만 사용
+
+#ifndef BOOT_LOGO
+#define BOOT_LOGO       0        // 1: 부팅 시 boot_logo_bus.h 에셋 표시
+#endif
+#ifndef CANVAS_ENABLE
+#define CANVAS_ENABLE   0        // 1: 캔버스 장면 사용 (RAM 약 5.3KB, 아래 저해상도 캔버스 절)
+#endif
+
+// 워드 3개 = 1바이트 (CS / RS 는 호출자가 설정)
+static inline void LCD_WriteBusWords(const uint32_t *w) {
+    GPIOB->BSRR = w[1];
+    GPIOC->BSRR = w[2];
+    GPIOA->BSRR = w[0];                  // D0/D2/D7 + WR LOW
+    __NOP();
+    LCD_WR_HIGH();
 }
 
-static void Eye_Normal(int16_t cx, int16_t ox, int16_t oy) {
-    int16_t sx = EYE_AREA_X + cx - EYE_W/2;
-    int16_t sy = EYE_AREA_Y + CY - EYE_H/2;
-    LCD_RoundRect(sx, sy, EYE_W, EYE_H, EYE_R, EYE_COLOR);
-    LCD_FillCircle(sx + 8 + ox, sy + 10 + oy, 5, EYE_BRIGHT);
+#if CANVAS_ENABLE
+// 런타임 인코딩 (팔레트 등), tools/busenc.c 의 encode_byte 와 같은 결과
+static void LCD_EncodeBusWords(uint8_t data, uint32_t *w) {
+    uint32_t pa = 0, pb = 0, pc = 0;
+
+    if(data & 0x01) pa |= GPIO_PIN_9;    // D0
+    if(data & 0x02) pc |= GPIO_PIN_7;    // D1
+    if(data & 0x04) pa |= GPIO_PIN_10;   // D2
+    if(data & 0x08) pb |= GPIO_PIN_3;    // D3
+    if(data & 0x10) pb |= GPIO_PIN_5;    // D4
+    if(data & 0x20) pb |= GPIO_PIN_4;    // D5
+    if(data & 0x40) pb |= GPIO_PIN_10;   // D6
+    if(data & 0x80) pa |= GPIO_PIN_8;    // D7
+
+    w[0] = pa | ((uint32_t)((GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10) & ~pa) << 16) | ((uint32_t)GPIO_PIN_1 << 16);
+    w[1] = pb | ((uint32_t)((GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_10) & ~pb) << 16);
+    w[2] = pc | ((uint32_t)(GPIO_PIN_7 & ~pc) << 16);
 }
+#endif
 
-static void Eye_Closed(int16_t cx) {
-    int16_t sx = EYE_AREA_X + cx - EYE_W/2 + 5;
-    int16_t sy = EYE_AREA_Y + CY;
-    LCD_FillRectFast(sx, sy - 3, EYE_W - 10, 7, EYE_COLOR);
+#if BOOT_LOGO
+#include "boot_logo_bus.h"               // BOOT_LOGO_W, BOOT_LOGO_H, boot_logo_bus[]
+
+// 걸치면 보이는 사각형만 윈도우로 잡고 행마다 잘린 워드를 건너뜀
+static void LCD_BlitBusWords(int16_t x, int16_t y, int16_t w, int16_t h, const uint32_t *words) {
+    if(w <= 0 || h <= 0) return;
+    x += lcd_ox;
+    y += lcd_oy;
+    int16_t x0 = x, y0 = y, x1 = x + w - 1, y1 = y + h - 1;
+    if(!LCD_ClipBox(&x0, &y0, &x1, &y1)) return;
+
+    uint16_t cw = x1 - x0 + 1;
+    LCD_SetWindow(x0, y0, x1, y1);
+
+    LCD_CS_LOW();
+    LCD_RS_HIGH();
+    for(int16_t yy = y0; yy <= y1; yy++) {
+        const uint32_t *p = words + ((uint32_t)(yy - y) * w + (x0 - x)) * 6;   // 픽셀당 워드 6개
+        for(uint16_t n = cw * 2; n; n--) {
+            LCD_WriteBusWords(p);
+            p += 3;
+        }
+    }
+    LCD_CS_HIGH();
+    lcd_bus_bytes += (uint32_t)cw * (y1 - y0 + 1) * 2;
 }
+#endif
 
-static void Eye_Half(int16_t cx, uint8_t pct) {
-    int16_t h = (EYE_H * pct) / 100;
-    if(h < 10) { Eye_Closed(cx); return; }
-    int16_t sx = EYE_AREA_X + cx - EYE_W/2;
-    int16_t sy = EYE_AREA_Y + CY + EYE_H/2 - h;
-    LCD_RoundRect(sx, sy, EYE_W, h, EYE_R/2, EYE_COLOR);
+// ============================================================================
+// ★ 그라데이션 (RGB565 성분별 고정소수점 증분, 행 구간 단위) ★
+// ============================================================================
+
+#ifndef EYE_SHADING
+#define EYE_SHADING     0        // 1: Eye_Normal 몸체를 세로 그라데이션으로
+#endif
+
+#if EYE_SHADING
+#define EYE_BODY_BOT    eye.dim  // 몸체 아래쪽 색 (위쪽은 EYE_COLOR)
+#else
+#define EYE_BODY_BOT    eye.color
+#endif
+
+// RGB565 성분별 16.16 고정소수점 스테퍼
+typedef struct {
+    int32_t r, g, b;
+    int32_t dr, dg, db;
+} Grad_t;
+
+// n 단계에 걸쳐 c0 → c1 (첫 단계 c0, 마지막 단계 c1)
+static void Grad_Init(Grad_t *gr, uint16_t c0, uint16_t c1, int16_t n) {
+    int32_t r0 = c0 >> 11, g0 = (c0 >> 5) & 0x3F, b0 = c0 & 0x1F;
+    int32_t r1 = c1 >> 11, g1 = (c1 >> 5) & 0x3F, b1 = c1 & 0x1F;
+    int32_t div = (n > 1) ? (n - 1) : 1;
+
+    gr->r = r0 << 16; gr->g = g0 << 16; gr->b = b0 << 16;
+    gr->dr = (r1 - r0) * 65536 / div;
+    gr->dg = (g1 - g0) * 65536 / div;
+    gr->db = (b1 - b0) * 65536 / div;
 }
 
-static void Eye_Happy(int16_t cx) {
-    int16_t bx = EYE_AREA_X + cx;
-    int16_t by = EYE_AREA_Y + CY;
-    for(int16_t i = -EYE_W/2 + 3; i <= EYE_W/2 - 3; i++) {
-        int32_t n = (int32_t)i * i * 100 / ((EYE_W/2) * (EYE_W/2));
-        int16_t y = by + 5 - (15 * (100 - n) / 100);
-        LCD_FillRectFast(bx + i, y - 4, 2, 6, EYE_COLOR);
-    }
+static inline void Grad_Step(Grad_t *gr) {
+    gr->r += gr->dr; gr->g += gr->dg; gr->b += gr->db;
 }
 
-static void Eye_Sad(int16_t cx) {
-    int16_t sx = EYE_AREA_X + cx - EYE_W/2;
-    int16_t sy = EYE_AREA_Y + CY - EYE_H/2 + 8;
-    LCD_RoundRect(sx, sy, EYE_W, EYE_H - 8, EYE_R, EYE_COLOR);
-    LCD_ThickLine(sx - 3, sy - 3, sx + EYE_W + 3, sy + 12, 5, EYE_COLOR);
+static inline void Grad_Skip(Grad_t *gr, int16_t k) {
+    gr->r += gr->dr * k; gr->g += gr->dg * k; gr->b += gr->db * k;
 }
 
-static void Eye_Angry(int16_t cx, uint8_t is_left) {
-    int16_t sx = EYE_AREA_X + cx - EYE_W/2;
-    int16_t sy = EYE_AREA_Y + CY - EYE_H/2 + 10;
-    LCD_RoundRect(sx, sy, EYE_W, EYE_H - 15, EYE_R - 3, EYE_COLOR);
-    if(is_left)
-        LCD_ThickLine(sx - 5, sy + 8, sx + EYE_W + 5, sy - 10, 6, EYE_COLOR);
-    else
-        LCD_ThickLine(sx - 5, sy - 10, sx + EYE_W + 5, sy + 8, 6, EYE_COLOR);
+static inline uint16_t Grad_Color(const Grad_t *gr) {
+    return (uint16_t)((((gr->r + 0x8000) >> 16) << 11) |
+                      (((gr->g + 0x8000) >> 16) << 5) |
+                       ((gr->b + 0x8000) >> 16));
 }
 
-static void Eye_Surprised(int16_t cx) {
-    int16_t x = EYE_AREA_X + cx;
-    int16_t y = EYE_AREA_Y + CY;
-    LCD_FillCircle(x, y, EYE_H/2 + 5, EYE_COLOR);
-    LCD_FillCircle(x, y, EYE_H/2 - 8, EYE_DIM);
-    LCD_FillCircle(x - 8, y - 8, 7, EYE_BRIGHT);
-    LCD_FillCircle(x + 4, y + 4, 4, EYE_BRIGHT);
+// 세로 그라데이션의 j 번째 행 색 (Grad_Step 누적과 같은 값)
+static uint16_t Grad_RowColor(uint16_t c0, uint16_t c1, int16_t j, int16_t n) {
+    Grad_t gr;
+    Grad_Init(&gr, c0, c1, n);
+    Grad_Skip(&gr, j);
+    return Grad_Color(&gr);
 }
 
-static void Eye_Heart(int16_t cx) {
-    int16_t x = EYE_AREA_X + cx;
-    int16_t y = EYE_AREA_Y + CY;
-    int16_t s = 18;
-    LCD_FillCircle(x - s/2 - 2, y - s/3, s/2 + 2, EYE_COLOR);
-    LCD_FillCircle(x + s/2 + 2, y - s/3, s/2 + 2, EYE_COLOR);
-    for(int16_t r = 0; r < s + 5; r++) {
-        int16_t w = s + 5 - r;
-        LCD_FillRectFast(x - w, y - s/3 + r, w * 2 + 1, 1, EYE_COLOR);
+#if EYE_SHADING                  // 음영 몸체에서만 씀 (스프라이트는 Grad_RowColor 만)
+
+// 둥근 사각형 세로 그라데이션: 행마다 구간 1개 (LCD_RoundRect 와 같은 모양, 겹침 없음)
+// 행 구간은 LCD_HLineFast 로 → 구간 기록 (타일 해시 / 구간 캐시) 을 거쳐 단색 채우기와 같은 비용
+static void LCD_RoundRectGradV(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+                               uint16_t c0, uint16_t c1) {
+    if(w <= 0 || h <= 0 || r > EYE_R_MAX || !LCD_Visible(x, y, x + w - 1, y + h - 1)) return;
+
+    uint8_t hw[EYE_R_MAX + 1];
+    Circle_HalfWidths(r, hw);
+
+    int16_t top = y + r, bot = y + h - r - 1;
+    Grad_t gr;
+    Grad_Init(&gr, c0, c1, h);
+
+    for(int16_t yy = y; yy < y + h; yy++) {
+        int16_t half = r;
+        if(yy < top) half = hw[top - yy];
+        else if(yy > bot) half = hw[yy - bot];
+        LCD_HLineFast(x + r - half, yy, w - 2*r + 2*half, Grad_Color(&gr));
+        Grad_Step(&gr);
     }
 }
 
-static void Eye_X(int16_t cx) {
-    int16_t x = EYE_AREA_X + cx;
-    int16_t y = EYE_AREA_Y + CY;
-    int16_t s = EYE_H/2 - 8;
-    LCD_ThickLine(x - s, y - s, x + s, y + s, 6, EYE_COLOR);
-    LCD_ThickLine(x + s, y - s, x - s, y + s, 6, EYE_COLOR);
-}
+#endif
 
 // ============================================================================
-// 표정 & 애니메이션
+// ★ 스프라이트 (하이라이트 / 동공) - 가장자리만 증분 이동 ★
 // ============================================================================
 
-static void Draw_Expression(Expression_t expr, int16_t ox, int16_t oy) {
-    Eye_Clear();
-    switch(expr) {
-        case EXPR_NORMAL:
-            Eye_Normal(LX, ox, oy);
-            Eye_Normal(RX, ox, oy);
-            break;
-        case EXPR_HAPPY:
-            Eye_Happy(LX);
-            Eye_Happy(RX);
-            break;
-        case EXPR_SAD:
-            Eye_Sad(LX);
-            Eye_Sad(RX);
-            break;
-        case EXPR_ANGRY:
-            Eye_Angry(LX, 1);
-            Eye_Angry(RX, 0);
-            break;
-        case EXPR_SURPRISED:
-            Eye_Surprised(LX);
-            Eye_Surprised(RX);
-            break;
-        case EXPR_SLEEPY:
-            Eye_Half(LX, 30);
-            Eye_Half(RX, 30);
-            break;
-        case EXPR_WINK_LEFT:
-            Eye_Closed(LX);
-            Eye_Normal(RX, 0, 0);
-            break;
-        case EXPR_WINK_RIGHT:
-            Eye_Normal(LX, 0, 0);
-            Eye_Closed(RX);
-            break;
-        case EXPR_BLINK:
-            Eye_Closed(LX);
-            Eye_Closed(RX);
-            break;
-        case EXPR_LOVE:
-            Eye_Heart(LX);
-            Eye_Heart(RX);
-            break;
-        case EXPR_DIZZY:
-            Eye_X(LX);
-            Eye_X(RX);
-            break;
-        case EXPR_LOOK_LEFT:
-            Eye_Normal(LX, -8, 0);
-            Eye_Normal(RX, -8, 0);
-            break;
-        case EXPR_LOOK_RIGHT:
-            Eye_Normal(LX, 8, 0);
-            Eye_Normal(RX, 8, 0);
-            break;
-        case EXPR_LOOK_UP:
-            Eye_Normal(LX, 0, -8);
-            Eye_Normal(RX, 0, -8);
-            break;
-        case EXPR_LOOK_DOWN:
-            Eye_Normal(LX, 0, 8);
-            Eye_Normal(RX, 0, 8);
-            break;
-    }
+#define SPRITE_MAX_R    8
+
+typedef struct {
+    int16_t x, y;                    // 현재 중심
+    int16_t r;
+    uint16_t color;
+    uint8_t hw[SPRITE_MAX_R + 1];    // 행별 반폭 (LCD_FillCircle 과 같은 모양)
+    // 아래 배경: 눈 몸체 둥근 사각형 (안쪽 bg, 바깥 EYE_BG)
+    int16_t bx, by, bw, bh, br;
+    uint16_t bg_top, bg_bot;         // 같으면 단색
+    uint8_t bg_hw[EYE_R_MAX + 1];
+} Sprite_t;
+
+// 스프라이트가 (cx, cy) 에 있을 때 yy 행의 구간
+static uint8_t Sprite_Row(const Sprite_t *s, int16_t cx, int16_t cy, int16_t yy, int16_t *x0, int16_t *x1) {
+    int16_t d = (yy > cy) ? (yy - cy) : (cy - yy);
+    if(d > s->r) return 0;
+    *x0 = cx - s->hw[d];
+    *x1 = cx + s->hw[d];
+    return 1;
 }
 
-static void Anim_SetExpr(Expression_t expr) {
-    current_expr = expr;
-    Draw_Expression(expr, 0, 0);
+// 배경 둥근 사각형의 yy 행 구간 (LCD_RoundRect 와 같은 모양)
+static uint8_t Sprite_BgRow(const Sprite_t *s, int16_t yy, int16_t *x0, int16_t *x1) {
+    if(yy < s->by || yy >= s->by + s->bh) return 0;
+    int16_t top = s->by + s->br;
+    int16_t bot = s->by + s->bh - s->br - 1;
+    int16_t half = s->br;
+    if(yy < top) half = s->bg_hw[top - yy];
+    else if(yy > bot) half = s->bg_hw[yy - bot];
+    *x0 = s->bx + s->br - half;
+    *x1 = s->bx + s->bw - s->br - 1 + half;
+    return 1;
 }
 
-static void Anim_Blink(void) {
-    Eye_Clear();
-    Eye_Half(LX, 50);
-    Eye_Half(RX, 50);
-
-    Eye_Clear();
-    Eye_Closed(LX);
-    Eye_Closed(RX);
-    HAL_Delay(40);
+// 스프라이트가 떠난 구간을 아래 배경으로 복원
+static void Sprite_Restore(const Sprite_t *s, int16_t yy, int16_t x0, int16_t x1) {
+    int16_t e0, e1;
+    if(!Sprite_BgRow(s, yy, &e0, &e1) || e1 < x0 || e0 > x1) {
+        LCD_HLineFast(x0, yy, x1 - x0 + 1, EYE_BG);
+        return;
+    }
+    if(x0 < e0) LCD_HLineFast(x0, yy, e0 - x0, EYE_BG);
+    int16_t a = (x0 > e0) ? x0 : e0;
+    int16_t b = (x1 < e1) ? x1 : e1;
+    uint16_t bg = s->bg_top;
+    if(s->bg_bot != s->bg_top) bg = Grad_RowColor(s->bg_top, s->bg_bot, yy - s->by, s->bh);
+    LCD_HLineFast(a, yy, b - a + 1, bg);
+    if(x1 > e1) LCD_HLineFast(e1 + 1, yy, x1 - e1, EYE_BG);
+}
 
-    Eye_Clear();
-    Eye_Half(LX, 50);
-    Eye_Half(RX, 50);
+// [a0, a1] 에서 [b0, b1] 을 뺀 나머지 (최대 2구간) 을 칠함
+static void Sprite_PaintDiff(const Sprite_t *s, int16_t yy, int16_t a0, int16_t a1,
+                             uint8_t has_b, int16_t b0, int16_t b1, uint8_t restore) {
+    int16_t seg[2][2];
+    uint8_t n = 0;
+
+    if(!has_b || b1 < a0 || b0 > a1) {
+        seg[n][0] = a0; seg[n][1] = a1; n++;
+    } else {
+        if(b0 > a0) { seg[n][0] = a0;     seg[n][1] = b0 - 1; n++; }
+        if(b1 < a1) { seg[n][0] = b1 + 1; seg[n][1] = a1;     n++; }
+    }
 
-    Draw_Expression(current_expr, 0, 0);
+    for(uint8_t i = 0; i < n; i++) {
+        if(restore) Sprite_Restore(s, yy, seg[i][0], seg[i][1]);
+        else LCD_HLineFast(seg[i][0], yy, seg[i][1] - seg[i][0] + 1, s->color);
+    }
 }
 
-static void Anim_WinkL(void) {
-    Eye_Clear();
-    Eye_Closed(LX);
-    Eye_Normal(RX, 0, 0);
-    HAL_Delay(180);
-    Draw_Expression(EXPR_NORMAL, 0, 0);
+// 이미 (x, y) 에 그려져 있는 원형 스프라이트를 등록
+static void Sprite_Init(Sprite_t *s, int16_t x, int16_t y, int16_t r, uint16_t color,
+                        int16_t bx, int16_t by, int16_t bw, int16_t bh, int16_t br,
+                        uint16_t bg_top, uint16_t bg_bot) {
+    if(r > SPRITE_MAX_R) r = SPRITE_MAX_R;
+    if(br > EYE_R_MAX) br = EYE_R_MAX;
+    s->x = x; s->y = y; s->r = r; s->color = color;
+    s->bx = bx; s->by = by; s->bw = bw; s->bh = bh; s->br = br;
+    s->bg_top = bg_top; s->bg_bot = bg_bot;
+    Circle_HalfWidths(r, s->hw);
+    Circle_HalfWidths(br, s->bg_hw);
 }
 
-static void Anim_WinkR(void) {
-    Eye_Clear();
-    Eye_Normal(LX, 0, 0);
-    Eye_Closed(RX);
-    HAL_Delay(180);
-    Draw_Expression(EXPR_NORMAL, 0, 0);
+// 이동: 새로 덮이는 앞쪽 가장자리와 드러나는 뒤쪽 가장자리만 전송
+static void Sprite_MoveTo(Sprite_t *s, int16_t nx, int16_t ny) {
+    if(nx == s->x && ny == s->y) return;
+
+    int16_t y0 = ((s->y < ny) ? s->y : ny) - s->r;
+    int16_t y1 = ((s->y > ny) ? s->y : ny) + s->r;
+
+    for(int16_t yy = y0; yy <= y1; yy++) {
+        int16_t o0 = 0, o1 = 0, n0 = 0, n1 = 0;
+        uint8_t has_o = Sprite_Row(s, s->x, s->y, yy, &o0, &o1);
+        uint8_t has_n = Sprite_Row(s, nx, ny, yy, &n0, &n1);
+
+        if(has_o) Sprite_PaintDiff(s, yy, o0, o1, has_n, n0, n1, 1);
+        if(has_n) Sprite_PaintDiff(s, yy, n0, n1, has_o, o0, o1, 0);
+    }
+
+    s->x = nx;
+    s->y = ny;
+}
+
+// 양쪽 눈 하이라이트 (Eye_Normal 계열이 화면에 있을 때만 유효)
+static Sprite_t eye_glint[2];
+static uint8_t glint_live = 0;
+static int16_t gaze_ox = 0, gaze_oy = 0;
+static uint8_t eye_shown = 0;    // 화면 눈 영역이 eye_layer_* 상태 그대로인지
+
+// ============================================================================
+// ★ 타일 해시 변경 감지 (프레임버퍼 없이 바뀐 16x16 타일만 전송) ★
+// ============================================================================
+// 1단계: 렌더러를 해시 모드로 실행, 타일마다 걸친 구간 (타일로 자른 좌표 + 색, 그린 순서) 을 누적
+// 2단계: 화면에 있는 해시와 다른 타일만, 이어진 묶음마다 클립해서 다시 렌더
+// LCD_FillRectFast / LCD_HLineFast 로만 그리는 렌더러에 사용 (그 밖의 출력은 해시되지 않음)
+// 렌더러 밖에서 그 영역을 그리면 Tile_Forget 으로 알려야 함
+
+#define TILE_ENABLE     1
+#define TILE_SIZE       16
+#define TILE_COLS       (LCD_W / TILE_SIZE)
+#define TILE_ROWS       (LCD_H / TILE_SIZE)
+#define TILE_RUNS_MAX   8        // 세로로 합치는 중인 묶음 수
+
+static uint16_t tile_hash[TILE_ROWS][TILE_COLS];     // 화면에 있는 내용, 0 = 모름
+static uint16_t tile_next[TILE_ROWS][TILE_COLS];     // 해시 모드 누적값
+
+static inline uint16_t Tile_Mix(uint16_t h, uint32_t v) {
+    h = (uint16_t)((h ^ (uint16_t)v) * 40503u);
+    return (uint16_t)((h ^ (uint16_t)(v >> 16)) * 40503u);
+}
+
+// 화면 좌표 사각형이 걸친 타일을 모름으로 표시 (다음 타일 렌더에서 다시 그림)
+static void Tile_Forget(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if(x0 < 0) x0 = 0;
+    if(y0 < 0) y0 = 0;
+    if(x1 > LCD_W - 1) x1 = LCD_W - 1;
+    if(y1 > LCD_H - 1) y1 = LCD_H - 1;
+    for(int16_t ty = y0 / TILE_SIZE; ty <= y1 / TILE_SIZE; ty++) {
+        for(int16_t tx = x0 / TILE_SIZE; tx <= x1 / TILE_SIZE; tx++) tile_hash[ty][tx] = 0;
+    }
+}
+
+// 해시 모드 싱크: 구간이 걸친 타일마다 잘린 좌표와 색을 누적
+static void Tile_HashSpan(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t x1 = x + w - 1, y1 = y + h - 1;
+    for(int16_t ty = y / TILE_SIZE; ty <= y1 / TILE_SIZE; ty++) {
+        int16_t cy0 = (y > ty * TILE_SIZE) ? y : ty * TILE_SIZE;
+        int16_t cy1 = (y1 < ty * TILE_SIZE + TILE_SIZE - 1) ? y1 : ty * TILE_SIZE + TILE_SIZE - 1;
+        for(int16_t tx = x / TILE_SIZE; tx <= x1 / TILE_SIZE; tx++) {
+            int16_t cx0 = (x > tx * TILE_SIZE) ? x : tx * TILE_SIZE;
+            int16_t cx1 = (x1 < tx * TILE_SIZE + TILE_SIZE - 1) ? x1 : tx * TILE_SIZE + TILE_SIZE - 1;
+            uint16_t *t = &tile_next[ty][tx];
+            *t = Tile_Mix(*t, ((uint32_t)(cx0 & 15) << 12) | ((cx1 & 15) << 8) | ((cy0 & 15) << 4) | (cy1 & 15));
+            *t = Tile_Mix(*t, color);
+        }
+    }
+}
+
+static void Tile_PaintRect(const Rect_t *r, uint16_t bg, void (*render)(void)) {
+    LCD_SetClip(r->x0, r->y0, r->x1, r->y1);
+    LCD_FillRectFast(r->x0, r->y0, r->x1 - r->x0 + 1, r->y1 - r->y0 + 1, bg);
+    render();
+}
+
+// 1단계: 해시만 (버스 전송 없음), 타일 안 클립 영역도 해시에 넣음 → tile_next
+static void Tile_Hash(const Rect_t *c, uint16_t bg, void (*render)(void)) {
+    int16_t tx0 = c->x0 / TILE_SIZE, tx1 = c->x1 / TILE_SIZE;
+    int16_t ty0 = c->y0 / TILE_SIZE, ty1 = c->y1 / TILE_SIZE;
+
+    for(int16_t ty = ty0; ty <= ty1; ty++) {
+        for(int16_t tx = tx0; tx <= tx1; tx++) {
+            int16_t cx0 = (c->x0 > tx * TILE_SIZE) ? c->x0 : tx * TILE_SIZE;
+            int16_t cy0 = (c->y0 > ty * TILE_SIZE) ? c->y0 : ty * TILE_SIZE;
+            tile_next[ty][tx] = Tile_Mix(0x811C, ((uint32_t)(cx0 & 15) << 4) | (cy0 & 15));
+        }
+    }
+    SpanList_t sink = { NULL, 0, 0, 0, Tile_HashSpan };
+    LCD_SetClip(c->x0, c->y0, c->x1, c->y1);
+    span_rec = &sink;
+    LCD_FillRectFast(c->x0, c->y0, c->x1 - c->x0 + 1, c->y1 - c->y0 + 1, bg);
+    render();
+    span_rec = NULL;
+}
+
+#if PARK_ENABLE
+// 영역 c 가 이미 bg + render 결과대로 화면에 있다고 기록 (전송 없음, 웜 재개용)
+static void Tile_Assume(const Rect_t *c, uint16_t bg, void (*render)(void)) {
+    Tile_Hash(c, bg, render);
+    for(int16_t ty = c->y0 / TILE_SIZE; ty <= c->y1 / TILE_SIZE; ty++) {
+        for(int16_t tx = c->x0 / TILE_SIZE; tx <= c->x1 / TILE_SIZE; tx++) {
+            tile_hash[ty][tx] = tile_next[ty][tx] ? tile_next[ty][tx] : 1;
+        }
+    }
+    LCD_ResetClip();
+}
+#endif
+
+// 불투명 영역 c 를 bg + render 로 그리되 해시가 바뀐 타일만 전송, 반환: 다시 그린 타일 수
+static uint16_t Tile_Paint(const Rect_t *c, uint16_t bg, void (*render)(void)) {
+    int16_t tx0 = c->x0 / TILE_SIZE, tx1 = c->x1 / TILE_SIZE;
+    int16_t ty0 = c->y0 / TILE_SIZE, ty1 = c->y1 / TILE_SIZE;
+
+    Tile_Hash(c, bg, render);
+
+    // 2단계: 가로로 이어진 바뀐 타일 묶음, 바로 위 행의 같은 묶음이면 세로로 합침
+    Rect_t run[TILE_RUNS_MAX];
+    uint8_t nrun = 0;
+    uint16_t painted = 0;
+
+    for(int16_t ty = ty0; ty <= ty1 + 1; ty++) {
+        uint8_t extended[TILE_RUNS_MAX] = { 0 };
+        int16_t tx = tx0;
+
+        while(ty <= ty1 && tx <= tx1) {
+            uint16_t h = tile_next[ty][tx] ? tile_next[ty][tx] : 1;
+            if(tile_hash[ty][tx] == h) { tx++; continue; }
+
+            int16_t start = tx;
+            while(tx <= tx1) {
+                h = tile_next[ty][tx] ? tile_next[ty][tx] : 1;
+                if(tile_hash[ty][tx] == h) break;
+                tile_hash[ty][tx] = h;
+                tx++;
+            }
+            painted += tx - start;
+
+            Rect_t t = { start * TILE_SIZE, ty * TILE_SIZE, tx * TILE_SIZE - 1, ty * TILE_SIZE + TILE_SIZE - 1 };
+            Rect_t r;
+            Rect_Intersect(&t, c, &r);
+
+            uint8_t i;
+            for(i = 0; i < nrun; i++) {
+                if(!extended[i] && run[i].x0 == r.x0 && run[i].x1 == r.x1) break;
+            }
+            if(i < nrun) {
+                run[i].y1 = r.y1;
+                extended[i] = 1;
+                continue;
+            }
+            if(nrun == TILE_RUNS_MAX) {          // 가득 차면 가장 오래된 묶음부터 그림
+                Tile_PaintRect(&run[0], bg, render);
+                memmove(&run[0], &run[1], sizeof(Rect_t) * (nrun - 1));
+                memmove(&extended[0], &extended[1], nrun - 1);
+                nrun--;
+            }
+            run[nrun] = r;
+            extended[nrun] = 1;
+            nrun++;
+        }
+
+        // 이번 행에서 이어지지 않은 묶음은 확정
+        for(uint8_t i = 0; i < nrun; ) {
+            if(extended[i]) { i++; continue; }
+            Tile_PaintRect(&run[i], bg, render);
+            run[i] = run[nrun - 1];
+            extended[i] = extended[nrun - 1];
+            nrun--;
+        }
+    }
+    LCD_ResetClip();
+    return painted;
+}
+
+// ============================================================================
+// 눈 그리기
+// ============================================================================
+
+static void Eye_Clear(void) {
+    glint_live = 0;
+    eye_shown = 0;
+    Tile_Forget(EYE_AREA_X, EYE_AREA_Y, EYE_AREA_X + EYE_AREA_W - 1, EYE_AREA_Y + EYE_AREA_H - 1);
+    LCD_FillRectSliced(EYE_AREA_X, EYE_AREA_Y, EYE_AREA_W, EYE_AREA_H, EYE_BG);
+}
+
+static void Eye_Body(int16_t cx) {
+    int16_t sx = EYE_AREA_X + cx - eye.w/2;
+    int16_t sy = EYE_AREA_Y + eye.cy - eye.h/2;
+#if EYE_SHADING
+    LCD_RoundRectGradV(sx, sy, eye.w, eye.h, eye.r, eye.color, EYE_BODY_BOT);
+#else
+    LCD_RoundRect(sx, sy, eye.w, eye.h, eye.r, eye.color);
+#endif
+}
+
+static void Eye_Glint(int16_t cx, int16_t ox, int16_t oy) {
+    int16_t sx = EYE_AREA_X + cx - eye.w/2;
+    int16_t sy = EYE_AREA_Y + eye.cy - eye.h/2;
+    LCD_FillCircle(sx + eye.glint_x + ox, sy + eye.glint_y + oy, eye.glint_r, eye.bright);
+}
+
+static void Eye_Normal(int16_t cx, int16_t ox, int16_t oy) {
+    Eye_Body(cx);
+    Eye_Glint(cx, ox, oy);
+}
+
+static void Eye_Closed(int16_t cx) {
+    int16_t sx = EYE_AREA_X + cx - eye.w/2 + 5;
+    int16_t sy = EYE_AREA_Y + eye.cy;
+    LCD_FillRectFast(sx, sy - 3, eye.w - 10, 7, eye.color);
+}
+
+static void Eye_Half(int16_t cx, uint8_t pct) {
+    int16_t h = (eye.h * pct) / 100;
+    if(h < 10) { Eye_Closed(cx); return; }
+    int16_t sx = EYE_AREA_X + cx - eye.w/2;
+    int16_t sy = EYE_AREA_Y + eye.cy + eye.h/2 - h;
+    LCD_RoundRect(sx, sy, eye.w, h, eye.r/2, eye.color);
+}
+
+static void Eye_Happy(int16_t cx) {
+    int16_t bx = EYE_AREA_X + cx;
+    int16_t by = EYE_AREA_Y + eye.cy;
+    for(int16_t i = -eye.w/2 + 3; i <= eye.w/2 - 3; i++) {
+        int32_t n = (int32_t)i * i * 100 / ((eye.w/2) * (eye.w/2));
+        int16_t y = by + 5 - (15 * (100 - n) / 100);
+        LCD_FillRectFast(bx + i, y - 4, 2, 6, eye.color);
+    }
+}
+
+static void Eye_Sad(int16_t cx) {
+    int16_t sx = EYE_AREA_X + cx - eye.w/2;
+    int16_t sy = EYE_AREA_Y + eye.cy - eye.h/2 + 8;
+    LCD_RoundRect(sx, sy, eye.w, eye.h - 8, eye.r, eye.color);
+    LCD_ThickLine(sx - 3, sy - 3, sx + eye.w + 3, sy + 12, 5, eye.color);
+}
+
+static void Eye_Angry(int16_t cx, uint8_t is_left) {
+    int16_t sx = EYE_AREA_X + cx - eye.w/2;
+    int16_t sy = EYE_AREA_Y + eye.cy - eye.h/2 + 10;
+    LCD_RoundRect(sx, sy, eye.w, eye.h - 15, eye.r - 3, eye.color);
+    if(is_left)
+        LCD_ThickLine(sx - 5, sy + 8, sx + eye.w + 5, sy - 10, 6, eye.color);
+    else
+        LCD_ThickLine(sx - 5, sy - 10, sx + eye.w + 5, sy + 8, 6, eye.color);
+}
+
+static void Eye_Surprised(int16_t cx) {
+    int16_t x = EYE_AREA_X + cx;
+    int16_t y = EYE_AREA_Y + eye.cy;
+    LCD_FillCircle(x, y, eye.h/2 + 5, eye.color);
+    LCD_FillCircle(x, y, eye.h/2 - 8, eye.dim);
+    LCD_FillCircle(x - 8, y - 8, 7, eye.bright);
+    LCD_FillCircle(x + 4, y + 4, 4, eye.bright);
+}
+
+static void Eye_Heart(int16_t cx) {
+    int16_t x = EYE_AREA_X + cx;
+    int16_t y = EYE_AREA_Y + eye.cy;
+    int16_t s = 18;
+    LCD_FillCircle(x - s/2 - 2, y - s/3, s/2 + 2, eye.color);
+    LCD_FillCircle(x + s/2 + 2, y - s/3, s/2 + 2, eye.color);
+    for(int16_t r = 0; r < s + 5; r++) {
+        int16_t w = s + 5 - r;
+        LCD_FillRectFast(x - w, y - s/3 + r, w * 2 + 1, 1, eye.color);
+    }
+}
+
+static void Eye_X(int16_t cx) {
+    int16_t x = EYE_AREA_X + cx;
+    int16_t y = EYE_AREA_Y + eye.cy;
+    int16_t s = eye.h/2 - 8;
+    LCD_ThickLine(x - s, y - s, x + s, y + s, 6, eye.color);
+    LCD_ThickLine(x + s, y - s, x - s, y + s, 6, eye.color);
+}
+
+// ============================================================================
+// ★ 눈 모양 구간 캐시 (한 번 기록, 평행이동 / 좌우반전 재생) ★
+// ============================================================================
+// 모든 모양은 왼쪽 눈(LX), 오프셋 0 으로 한 번만 래스터화해서 기록
+// 오른쪽 눈은 RX-LX 평행이동, EXPR_ANGRY 오른쪽은 좌우반전, 시선은 하이라이트 평행이동
+
+#define SPAN_CACHE_ENABLE   1
+#define SPAN_POOL_SIZE      768      // 구간 8바이트 → 6KB
+
+typedef enum {
+    SHAPE_NONE = 0,
+    SHAPE_BODY, SHAPE_GLINT, SHAPE_CLOSED, SHAPE_SLEEPY, SHAPE_HAPPY, SHAPE_SAD,
+    SHAPE_ANGRY, SHAPE_SURPRISED, SHAPE_HEART, SHAPE_X,
+    SHAPE_COUNT
+} EyeShape_t;
+
+// 모양을 눈 중심 cx 에 직접 래스터화 (is_left: EXPR_ANGRY 눈썹 방향)
+static void Shape_Raster(uint8_t shape, int16_t cx, int16_t ox, int16_t oy, uint8_t is_left) {
+    switch(shape) {
+        case SHAPE_BODY:      Eye_Body(cx); break;
+        case SHAPE_GLINT:     Eye_Glint(cx, ox, oy); break;
+        case SHAPE_CLOSED:    Eye_Closed(cx); break;
+        case SHAPE_SLEEPY:    Eye_Half(cx, 30); break;
+        case SHAPE_HAPPY:     Eye_Happy(cx); break;
+        case SHAPE_SAD:       Eye_Sad(cx); break;
+        case SHAPE_ANGRY:     Eye_Angry(cx, is_left); break;
+        case SHAPE_SURPRISED: Eye_Surprised(cx); break;
+        case SHAPE_HEART:     Eye_Heart(cx); break;
+        case SHAPE_X:         Eye_X(cx); break;
+    }
+}
+
+#if SPAN_CACHE_ENABLE
+
+typedef struct {
+    uint16_t start, n;
+    uint8_t valid;
+} SpanCacheEntry_t;
+
+static Span_t span_pool[SPAN_POOL_SIZE];
+static uint16_t span_pool_used = 0;
+static SpanCacheEntry_t span_cache[SHAPE_COUNT];
+static uint32_t span_cache_key = 0;   // 기록 당시 eye_hash
+
+static void SpanCache_Clear(void) {
+    memset(span_cache, 0, sizeof(span_cache));
+    span_pool_used = 0;
+}
+
+// 일괄 그리기가 윈도우를 재사용하도록 열 (x, w) 순 → 행 순으로 (기록 때 한 번, 재생은 여러 번)
+// 같은 열에서 위아래로 맞닿은 1행 구간은 명령 없이 이어 씀
+// 안정 삽입 정렬, 1행 구간만 옮기고 겹치는 다른 색 구간은 넘지 않음 → 재생 결과는 기록 순서와 같음
+// 여러 행 구간 (두꺼운 선 스탬프) 은 제자리: 거친 재생이 이웃 스탬프 순서로 건너뛸 것을 고름
+static inline int32_t Span_Key(const Span_t *a) {
+    return ((int32_t)a->x << 20) | ((int32_t)a->w << 12) | a->y;     // 화면 안 좌표 (0 이상)
+}
+
+static void Span_Sort(Span_t *sp, uint16_t n) {
+    for(uint16_t i = 1; i < n; i++) {
+        Span_t t = sp[i];
+        int32_t k = Span_Key(&t);
+        uint16_t j = i;
+        while(j > 0 && t.h == 1 && k < Span_Key(&sp[j - 1])) {
+            const Span_t *p = &sp[j - 1];
+            if(p->h != 1) break;
+            if(p->color != t.color && p->y == t.y && p->x < t.x + t.w && t.x < p->x + p->w) break;
+            sp[j] = sp[j - 1];
+            j--;
+        }
+        sp[j] = t;
+    }
+}
+
+// 캐시된 모양 (없으면 기록), 풀이 모자라면 NULL
+static const SpanCacheEntry_t *SpanCache_Get(uint8_t shape) {
+    SpanCacheEntry_t *e = &span_cache[shape];
+    if(span_cache_key != eye_hash) {  // 파라미터가 바뀌면 전부 다시 기록
+        SpanCache_Clear();
+        span_cache_key = eye_hash;
+    }
+    if(e->valid) return e;
+
+    for(uint8_t attempt = 0; attempt < 2; attempt++) {
+        SpanList_t list = { &span_pool[span_pool_used], 0, SPAN_POOL_SIZE - span_pool_used, 0, NULL };
+        Rect_t saved = lcd_clip;
+        int16_t ox = lcd_ox, oy = lcd_oy;
+        SpanList_t *saved_rec = span_rec;    // 타일 해시 중에도 호출됨
+
+        LCD_ResetClip();             // 기록은 클립 / 뷰포트 없이 전체 모양
+        lcd_ox = lcd_oy = 0;
+        span_rec = &list;
+        Shape_Raster(shape, eye.lx, 0, 0, 1);
+        span_rec = saved_rec;
+        lcd_clip = saved;
+        lcd_ox = ox;
+        lcd_oy = oy;
+
+        if(!list.overflow) {
+            Span_Sort(list.buf, list.n);
+            e->start = span_pool_used;
+            e->n = list.n;
+            e->valid = 1;
+            span_pool_used += list.n;
+            return e;
+        }
+        if(span_pool_used == 0) break;
+        SpanCache_Clear();           // 풀을 비우고 한 번 더
+    }
+    return NULL;
+}
+
+// 재생: (mirror 이면 mx 기준 좌우반전 후) dx, dy 평행이동
+static void Span_Replay(const Span_t *sp, uint16_t n, int16_t dx, int16_t dy, uint8_t mirror, int16_t mx) {
+    LCD_DrawSpans(sp, n, dx, dy, mirror, mx);
+}
+
+// 거친 재생에서 쓸 구간인지 (1행 구간은 짝수 행만 2행 높이로, 두꺼운 선 스탬프는 1px 이웃을 건너뜀)
+static uint8_t Span_CoarseKeep(const Span_t *sp, const Span_t **last, uint8_t *h) {
+    *h = sp->h;
+    if(sp->h == 1) {
+        if(sp->y & 1) return 0;
+        *h = 2;
+        return 1;
+    }
+    const Span_t *l = *last;
+    if(l && l->w == sp->w && l->h == sp->h && l->color == sp->color &&
+       abs(l->x - sp->x) <= 1 && abs(l->y - sp->y) <= 1) return 0;
+    *last = sp;
+    return 1;
+}
+
+// 호는 2행 계단, 두꺼운 선은 스탬프 절반 (프레임 예산 초과 시)
+static void Span_ReplayCoarse(const Span_t *sp, uint16_t n, int16_t dx, int16_t dy, uint8_t mirror, int16_t mx) {
+    Span_t keep[32];             // 남길 구간을 모아 일괄 그리기
+    uint8_t k = 0;
+    const Span_t *last = NULL;
+    for(uint16_t i = 0; i < n; i++) {
+        keep[k] = sp[i];
+        if(!Span_CoarseKeep(&sp[i], &last, &keep[k].h)) continue;
+        if(++k == 32) { Span_Replay(keep, k, dx, dy, mirror, mx); k = 0; }
+    }
+    Span_Replay(keep, k, dx, dy, mirror, mx);
+}
+
+#endif
+
+// ============================================================================
+// ★ 프레임 통계 & HUD 오버레이 ★
+// ============================================================================
+
+#define FRAME_BUDGET_US     16667    // 60Hz 프레임 슬롯
+
+typedef struct {
+    uint32_t start_cycles;   // 현재 프레임 시작 시점
+    uint32_t start_bytes;
+    uint32_t frame_us;       // 마지막 프레임 시간
+    uint32_t frame_bytes;    // 마지막 프레임 버스 바이트
+    uint32_t dropped;        // 예산 초과로 놓친 프레임 슬롯 누계
+    uint32_t fps_tick;       // FPS 측정 구간 시작 (ms)
+    uint16_t fps_frames;
+    uint16_t fps;
+} FrameStats_t;
+
+static FrameStats_t frame_stats;
+
+// ★ 프레임 예산 조절기 상태 (계획은 Gov_Plan, 표정 그리기 앞) ★
+#define GOV_BUDGET_BYTES    40000    // 프레임당 버스 바이트 예산
+#define GOV_WINDOW_BYTES    11       // 구간당 CASET/PASET/RAMWR 오버헤드
+#define GOV_CPB_INIT        20       // 버스 바이트당 사이클 초기 추정 (실측으로 갱신)
+#define GOV_SPLIT_MAX       4        // 최대 분할 프레임 수
+#define GOV_SLOT_MS         ((FRAME_BUDGET_US + 999) / 1000)    // 분할한 띠 사이 간격
+
+#define GOV_NO_GLINT        0x01     // 하이라이트 생략
+#define GOV_COARSE          0x02     // 거친 호 / 선
+#define GOV_SPLIT           0x04     // 여러 프레임에 나눠 그림
+
+typedef struct {
+    uint32_t budget_bytes;
+    uint32_t budget_cycles;  // 0 이면 FRAME_BUDGET_US 에서 계산
+    uint32_t cpb_q8;         // 바이트당 사이클 (x256), 큰 프레임에서 이동 평균
+    uint8_t mode;            // 지금 그리는 프레임에 적용 중인 단계
+    uint8_t lost;            // 화면에 남아 있는 생략 (GOV_NO_GLINT / GOV_COARSE)
+    uint8_t band, bands;     // 분할 중인 표정: 다음 띠 / 전체 띠 (0 = 분할 중 아님)
+    int16_t band_y;          // 다음 띠 시작 y
+    uint32_t band_tick;      // 마지막 띠를 그린 시각 (ms)
+} Gov_t;
+
+typedef struct {
+    uint32_t planned;        // 계획한 프레임
+    uint32_t no_glint;       // 단계별 적용 횟수
+    uint32_t coarse;
+    uint32_t split;
+    uint32_t over;           // 최대 단계로도 예산 초과
+    uint32_t last_est;       // 마지막 예상 바이트 (분할 전)
+    uint8_t last_mode;
+    uint8_t last_bands;
+} GovStats_t;
+
+static Gov_t gov = { GOV_BUDGET_BYTES, 0, GOV_CPB_INIT * 256, 0, 0, 0, 0, 0, 0 };
+static GovStats_t gov_stats;
+
+// 사이클 예산을 바이트로 환산한 값과 바이트 예산 중 작은 쪽
+static uint32_t Gov_LimitBytes(void) {
+    uint32_t cyc = gov.budget_cycles ? gov.budget_cycles
+                                     : FRAME_BUDGET_US * (SystemCoreClock / 1000000);
+    uint32_t by_cyc = (uint32_t)(((uint64_t)cyc << 8) / gov.cpb_q8);
+    return (by_cyc < gov.budget_bytes) ? by_cyc : gov.budget_bytes;
+}
+
+#if HUD_ENABLE
+
+#define HUD_X           4
+#define HUD_Y           4
+#define HUD_LINES       2
+#define HUD_COLS        38
+#define HUD_FG          0x8410   // GRAY
+#define HUD_BG          EYE_BG
+
+#if HUD_Y + HUD_LINES * GLYPH_H > EYE_AREA_Y
+#error "HUD overlaps the eye area"
+#endif
+
+static char hud_shown[HUD_LINES][HUD_COLS];   // 현재 화면에 그려진 글자
+
+// 오른쪽 정렬 10진수 (폭 초과 시 '*' 채움)
+static void HUD_PutU(char *dst, uint32_t v, uint8_t width) {
+    for(int8_t i = width - 1; i >= 0; i--) {
+        if(v == 0 && i < width - 1) { dst[i] = ' '; continue; }
+        dst[i] = '0' + (v % 10);
+        v /= 10;
+    }
+    if(v) memset(dst, '*', width);
+}
+
+static void HUD_Init(void) {
+    // LCD_Fill 직후 띠는 HUD_BG 이므로 공백으로 간주
+    memset(hud_shown, ' ', sizeof(hud_shown));
+}
+
+// 바뀐 글자만 다시 그림 (이어진 글자 묶음당 윈도우 1회)
+static void HUD_Update(void) {
+    char line[HUD_LINES][HUD_COLS];
+    memset(line, ' ', sizeof(line));
+
+    memcpy(&line[0][0], "FPS", 3);   HUD_PutU(&line[0][4], frame_stats.fps, 3);
+    memcpy(&line[0][9], "FT", 2);    HUD_PutU(&line[0][12], frame_stats.frame_us, 6);
+    memcpy(&line[0][18], "us", 2);
+    memcpy(&line[0][24], "GOV", 3);
+    line[0][28] = (gov_stats.last_mode & GOV_NO_GLINT) ? 'G' : '-';
+    line[0][29] = (gov_stats.last_mode & GOV_COARSE) ? 'C' : '-';
+    line[0][30] = (gov_stats.last_mode & GOV_SPLIT) ? '0' + gov_stats.last_bands : '-';
+    memcpy(&line[1][0], "BUS", 3);   HUD_PutU(&line[1][4], frame_stats.frame_bytes, 7);
+    memcpy(&line[1][11], "B", 1);
+    memcpy(&line[1][14], "DROP", 4); HUD_PutU(&line[1][19], frame_stats.dropped, 6);
+
+    for(uint8_t r = 0; r < HUD_LINES; r++) {
+        for(uint8_t c = 0; c < HUD_COLS; ) {
+            if(line[r][c] == hud_shown[r][c]) { c++; continue; }
+            uint8_t start = c;
+            while(c < HUD_COLS && line[r][c] != hud_shown[r][c]) { hud_shown[r][c] = line[r][c]; c++; }
+            LCD_DrawText(HUD_X + start * GLYPH_W, HUD_Y + r * GLYPH_H, &line[r][start], c - start, HUD_FG, HUD_BG);
+        }
+    }
+}
+
+// 상태 레이어를 다시 합성하면 HUD 줄도 bg 로 지워짐 → hud_shown 그대로 다시 그림 (클립 적용)
+static void HUD_Redraw(void) {
+    for(uint8_t r = 0; r < HUD_LINES; r++) {
+        for(uint8_t c = 0; c < HUD_COLS; ) {
+            if(hud_shown[r][c] == ' ') { c++; continue; }
+            uint8_t start = c;
+            while(c < HUD_COLS && hud_shown[r][c] != ' ') c++;
+            LCD_DrawText(HUD_X + start * GLYPH_W, HUD_Y + r * GLYPH_H, &hud_shown[r][start], c - start, HUD_FG, HUD_BG);
+        }
+    }
+}
+
+#endif
+
+static void Frame_Begin(void) {
+    frame_stats.start_cycles = Perf_Cycles();
+    frame_stats.start_bytes = lcd_bus_bytes;
+}
+
+static void Frame_End(void) {
+    uint32_t cycles = Perf_Cycles() - frame_stats.start_cycles;
+    uint32_t us = Perf_CyclesToUs(cycles);
+    frame_stats.frame_us = us;
+    frame_stats.frame_bytes = lcd_bus_bytes - frame_stats.start_bytes;
+    if(us > FRAME_BUDGET_US) frame_stats.dropped += (us - 1) / FRAME_BUDGET_US;
+
+    // 버스가 지배하는 큰 프레임으로 바이트당 사이클 보정
+    if(frame_stats.frame_bytes >= 4096) {
+        uint32_t cpb = (uint32_t)(((uint64_t)cycles << 8) / frame_stats.frame_bytes);
+        if(cpb < 256) cpb = 256;     // 바이트당 1사이클 미만은 측정 오류
+        gov.cpb_q8 = (gov.cpb_q8 * 7 + cpb) / 8;
+    }
+
+    uint32_t t = HAL_GetTick();
+    frame_stats.fps_frames++;
+    if(t - frame_stats.fps_tick >= 1000) {
+        frame_stats.fps = (uint16_t)((uint32_t)frame_stats.fps_frames * 1000 / (t - frame_stats.fps_tick));
+        frame_stats.fps_frames = 0;
+        frame_stats.fps_tick = t;
+    }
+
+#if HUD_ENABLE
+    HUD_Update();    // HUD 자체 전송량은 프레임 통계에서 제외
+#endif
+}
+
+// ============================================================================
+// ★ 레이어 합성기 (z 순서 + 레이어별 무효 영역) ★
+// ============================================================================
+// 무효 사각형은 자기 레이어 영역 안으로 잘리고, 겹치는 레이어만 다시 그림
+// → 상태 표시줄 갱신이 눈을 다시 그리게 하지 않고, 그 반대도 마찬가지
+
+#define LAYER_MAX           4
+#define LAYER_DIRTY_MAX     4
+
+typedef void (*LayerRender_t)(void);     // lcd_clip 이 설정된 상태로 호출
+
+typedef struct {
+    Rect_t bounds;
+    uint8_t z;                   // 작을수록 아래
+    uint8_t visible;
+    uint8_t opaque;              // 1: 그리기 전에 bg 로 클립 영역을 채움
+    uint8_t tiled;               // 1: 불투명 + 맨 아래일 때 바뀐 타일만 전송 (Tile_Paint)
+    uint16_t bg;
+    uint8_t ndirty;
+    Rect_t dirty[LAYER_DIRTY_MAX];
+    LayerRender_t render;
+} Layer_t;
+
+static Layer_t layers[LAYER_MAX];
+static uint8_t layer_order[LAYER_MAX];   // z 오름차순 레이어 번호
+static uint8_t layer_count = 0;
+
+// 레이어 추가, 반환: 레이어 번호 또는 -1
+static int8_t Layer_Add(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t z,
+                        uint8_t opaque, uint16_t bg, LayerRender_t render) {
+    if(layer_count >= LAYER_MAX) return -1;
+
+    Layer_t *l = &layers[layer_count];
+    l->bounds.x0 = x; l->bounds.y0 = y;
+    l->bounds.x1 = x + w - 1; l->bounds.y1 = y + h - 1;
+    l->z = z;
+    l->visible = 1;
+    l->opaque = opaque;
+    l->tiled = 0;
+    l->bg = bg;
+    l->ndirty = 0;
+    l->render = render;
+
+    // 그리기 순서에 삽입 (같은 z 는 먼저 추가된 것이 아래)
+    uint8_t pos = layer_count;
+    while(pos > 0 && layers[layer_order[pos - 1]].z > z) {
+        layer_order[pos] = layer_order[pos - 1];
+        pos--;
+    }
+    layer_order[pos] = layer_count;
+    return layer_count++;
+}
+
+static void Layer_Invalidate(int8_t id, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if(id < 0 || id >= layer_count || w <= 0 || h <= 0) return;
+
+    Layer_t *l = &layers[id];
+    Rect_t r = { x, y, x + w - 1, y + h - 1 };
+    if(!Rect_Intersect(&r, &l->bounds, &r)) return;
+
+    // 겹치는 기존 영역과 합침
+    for(uint8_t i = 0; i < l->ndirty; i++) {
+        Rect_t tmp;
+        if(Rect_Intersect(&l->dirty[i], &r, &tmp)) {
+            Rect_Union(&l->dirty[i], &r);
+            return;
+        }
+    }
+    if(l->ndirty < LAYER_DIRTY_MAX) {
+        l->dirty[l->ndirty++] = r;
+        return;
+    }
+
+    // 가득 차면 면적이 가장 적게 늘어나는 쪽에 합침 (레이어 영역은 벗어나지 않음)
+    uint8_t best = 0;
+    int32_t best_growth = 0x7FFFFFFF;
+    for(uint8_t i = 0; i < l->ndirty; i++) {
+        Rect_t u = l->dirty[i];
+        Rect_Union(&u, &r);
+        int32_t growth = Rect_Area(&u) - Rect_Area(&l->dirty[i]);
+        if(growth < best_growth) { best_growth = growth; best = i; }
+    }
+    Rect_Union(&l->dirty[best], &r);
+}
+
+// 영역 r 을 z 순서대로 해당 레이어들만 클립해서 그림
+static void Compositor_Paint(const Rect_t *r) {
+    for(uint8_t k = 0; k < layer_count; k++) {
+        Layer_t *l = &layers[layer_order[k]];
+        Rect_t c;
+        if(!l->visible || !Rect_Intersect(r, &l->bounds, &c)) continue;
+
+#if TILE_ENABLE
+        // 아래에 먼저 그려진 레이어가 없어야 건너뛴 타일이 그대로 남음
+        uint8_t bottom = 1;
+        for(uint8_t j = 0; j < k && bottom; j++) {
+            Rect_t o;
+            const Layer_t *u = &layers[layer_order[j]];
+            if(u->visible && Rect_Intersect(&c, &u->bounds, &o)) bottom = 0;
+        }
+        if(l->tiled && l->opaque && l->render && bottom) {
+            Tile_Paint(&c, l->bg, l->render);
+            continue;
+        }
+#endif
+        LCD_SetClip(c.x0, c.y0, c.x1, c.y1);
+        if(l->opaque) LCD_FillRectFast(c.x0, c.y0, c.x1 - c.x0 + 1, c.y1 - c.y0 + 1, l->bg);
+        if(l->render) l->render();
+    }
+    LCD_ResetClip();
+}
+
+// 한 프레임분 무효 영역을 모두 다시 그리고 비움
+static void Compositor_Present(void) {
+    for(uint8_t i = 0; i < layer_count; i++) {
+        Layer_t *l = &layers[i];
+        for(uint8_t d = 0; d < l->ndirty; d++) {
+            // 이미 그린 다른 레이어의 영역에 완전히 포함되면 생략
+            uint8_t covered = 0;
+            for(uint8_t j = 0; j < i && !covered; j++) {
+                for(uint8_t e = 0; e < layers[j].ndirty; e++) {
+                    const Rect_t *o = &layers[j].dirty[e];
+                    if(o->x0 <= l->dirty[d].x0 && o->y0 <= l->dirty[d].y0 &&
+                       o->x1 >= l->dirty[d].x1 && o->y1 >= l->dirty[d].y1) { covered = 1; break; }
+                }
+            }
+            if(!covered) Compositor_Paint(&l->dirty[d]);
+        }
+    }
+    for(uint8_t i = 0; i < layer_count; i++) layers[i].ndirty = 0;
+}
+
+// ============================================================================
+// ★ 위젯 (막대 / 원호 게이지 / 7세그먼트 숫자) - 바뀐 부분만 다시 그림 ★
+// ============================================================================
+// 위젯마다 마지막으로 그린 상태를 기억하고 값이 바뀌면 차이만 전송
+// 막대: 이전 / 새 채움 경계 사이 띠, 게이지: 쓸고 지나간 부채꼴, 숫자: 켜지고 꺼진 세그먼트
+
+typedef struct {
+    int16_t x, y, w, h;
+    uint8_t vertical;            // 1: 아래에서 위로 채움
+    uint16_t fg, bg, frame;      // frame == bg 이면 테두리 없음
+    uint16_t value, max;
+    int16_t shown;               // 화면의 채움 길이 (px), -1 = 안 그려짐
+} Bar_t;
+
+// 테두리 안쪽 채움 영역
+static void Bar_Inner(const Bar_t *b, int16_t *x, int16_t *y, int16_t *w, int16_t *h) {
+    uint8_t f = (b->frame != b->bg) ? 1 : 0;
+    *x = b->x + f; *y = b->y + f;
+    *w = b->w - 2 * f; *h = b->h - 2 * f;
+}
+
+static int16_t Bar_Length(const Bar_t *b, uint16_t value) {
+    int16_t x, y, w, h;
+    Bar_Inner(b, &x, &y, &w, &h);
+    if(value > b->max) value = b->max;
+    return (int16_t)((int32_t)(b->vertical ? h : w) * value / b->max);
+}
+
+// 채움 방향 기준 [from, to) 띠를 color 로
+static void Bar_Strip(const Bar_t *b, int16_t from, int16_t to, uint16_t color) {
+    int16_t x, y, w, h;
+    Bar_Inner(b, &x, &y, &w, &h);
+    if(to <= from) return;
+    if(b->vertical) LCD_FillRectFast(x, y + h - to, w, to - from, color);
+    else LCD_FillRectFast(x + from, y, to - from, h, color);
+}
+
+static void Bar_Init(Bar_t *b, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t vertical,
+                     uint16_t fg, uint16_t bg, uint16_t frame, uint16_t max) {
+    b->x = x; b->y = y; b->w = w; b->h = h;
+    b->vertical = vertical;
+    b->fg = fg; b->bg = bg; b->frame = frame;
+    b->value = 0;
+    b->max = max ? max : 1;
+    b->shown = -1;
+}
+
+// 전체 그리기 (레이어 다시 그리기 / 처음)
+static void Bar_Draw(Bar_t *b) {
+    int16_t x, y, w, h;
+    Bar_Inner(b, &x, &y, &w, &h);
+    if(b->frame != b->bg) {
+        int16_t x1 = b->x + b->w - 1, y1 = b->y + b->h - 1;
+        const Rect_t edge[4] = {
+            { b->x, b->y, x1, b->y }, { b->x, y1, x1, y1 },
+            { b->x, b->y + 1, b->x, y1 - 1 }, { x1, b->y + 1, x1, y1 - 1 }
+        };
+        LCD_FillRects(edge, 4, b->frame);
+    }
+    int16_t len = Bar_Length(b, b->value);
+    Bar_Strip(b, 0, len, b->fg);
+    Bar_Strip(b, len, b->vertical ? h : w, b->bg);
+    b->shown = len;
+}
+
+// 값 변경: 이전 경계와 새 경계 사이 띠만
+static void Bar_Set(Bar_t *b, uint16_t value) {
+    b->value = value;
+    if(b->shown < 0) { Bar_Draw(b); return; }
+
+    int16_t len = Bar_Length(b, value);
+    if(len > b->shown) Bar_Strip(b, b->shown, len, b->fg);
+    else Bar_Strip(b, len, b->shown, b->bg);
+    b->shown = len;
+}
+
+// sin(0..90도) x 16384
+static const uint16_t sin_q14[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+static int32_t Sin_Q14(int16_t deg) {
+    deg %= 360;
+    if(deg < 0) deg += 360;
+    if(deg <= 90) return sin_q14[deg];
+    if(deg <= 180) return sin_q14[180 - deg];
+    if(deg <= 270) return -(int32_t)sin_q14[deg - 180];
+    return -(int32_t)sin_q14[360 - deg];
+}
+
+// 각도 방향 단위 벡터 (12시 = 0, 시계 방향, 화면 좌표 y 아래)
+static inline void Angle_Dir(int16_t deg, int32_t *ux, int32_t *uy) {
+    *ux = Sin_Q14(deg);
+    *uy = -Sin_Q14(deg + 90);
+}
+
+typedef struct {
+    int16_t cx, cy;
+    int16_t r_in, r_out;
+    int16_t start, sweep;        // 도 (12시 = 0, 시계 방향)
+    uint16_t fg, track;
+    uint16_t value, max;
+    int16_t shown;               // 화면의 채움 각도 (start 기준), -1 = 안 그려짐
+} Gauge_t;
+
+// 고리 안 [a0, a1) 부채꼴 (a1 - a0 <= 90), 시작 경계 포함 / 끝 경계 제외
+static void Gauge_Sector(const Gauge_t *g, int16_t a0, int16_t a1, uint16_t color) {
+    int32_t ax, ay, bx, by;
+    Angle_Dir(a0, &ax, &ay);
+    Angle_Dir(a1, &bx, &by);
+
+    // 경계 상자: 네 모서리 점 + 사이에 걸친 축 방향 끝점
+    int16_t x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+    int32_t px[6], py[6];
+    uint8_t np = 0;
+    px[np] = ax * g->r_in;  py[np++] = ay * g->r_in;
+    px[np] = ax * g->r_out; py[np++] = ay * g->r_out;
+    px[np] = bx * g->r_in;  py[np++] = by * g->r_in;
+    px[np] = bx * g->r_out; py[np++] = by * g->r_out;
+    for(int16_t k = ((a0 + 89) / 90) * 90; k < a1 && np < 6; k += 90) {
+        int32_t kx, ky;
+        Angle_Dir(k, &kx, &ky);
+        px[np] = kx * g->r_out; py[np++] = ky * g->r_out;
+    }
+    for(uint8_t i = 0; i < np; i++) {
+        int16_t qx = (int16_t)((px[i] + (px[i] >= 0 ? 8191 : -8191)) / 16384);
+        int16_t qy = (int16_t)((py[i] + (py[i] >= 0 ? 8191 : -8191)) / 16384);
+        if(i == 0 || qx < x0) x0 = qx;
+        if(i == 0 || qx > x1) x1 = qx;
+        if(i == 0 || qy < y0) y0 = qy;
+        if(i == 0 || qy > y1) y1 = qy;
+    }
+    x0--; x1++; y0--; y1++;          // 반올림 여유
+
+    int32_t ri2 = (int32_t)g->r_in * g->r_in - g->r_in;      // 반지름 ±0.5 경계
+    int32_t ro2 = (int32_t)g->r_out * g->r_out + g->r_out;
+    for(int16_t dy = y0; dy <= y1; dy++) {
+        int16_t run = 0;
+        uint8_t open = 0;
+        for(int16_t dx = x0; dx <= x1 + 1; dx++) {
+            uint8_t in = 0;
+            if(dx <= x1) {
+                int32_t d2 = (int32_t)dx * dx + (int32_t)dy * dy;
+                in = d2 > ri2 && d2 <= ro2 &&
+                     ax * dy - ay * dx >= 0 &&       // a0 에서 시계 방향 쪽
+                     dx * by - dy * bx > 0;          // a1 에 못 미침
+            }
+            if(in && !open) { run = dx; open = 1; }
+            if(!in && open) {
+                LCD_HLineFast(g->cx + run, g->cy + dy, dx - run, color);
+                open = 0;
+            }
+        }
+    }
+}
+
+// [a0, a1) 를 90도 이하 조각으로
+static void Gauge_Wedge(const Gauge_t *g, int16_t a0, int16_t a1, uint16_t color) {
+    while(a0 < a1) {
+        int16_t e = (a1 - a0 > 90) ? a0 + 90 : a1;
+        Gauge_Sector(g, a0, e, color);
+        a0 = e;
+    }
+}
+
+static int16_t Gauge_Angle(const Gauge_t *g, uint16_t value) {
+    if(value > g->max) value = g->max;
+    return (int16_t)((int32_t)g->sweep * value / g->max);
+}
+
+static void Gauge_Init(Gauge_t *g, int16_t cx, int16_t cy, int16_t r_in, int16_t r_out,
+                       int16_t start, int16_t sweep, uint16_t fg, uint16_t track, uint16_t max) {
+    g->cx = cx; g->cy = cy;
+    g->r_in = r_in; g->r_out = r_out;
+    g->start = start; g->sweep = (sweep > 360) ? 360 : sweep;
+    g->fg = fg; g->track = track;
+    g->value = 0;
+    g->max = max ? max : 1;
+    g->shown = -1;
+}
+
+static void Gauge_Draw(Gauge_t *g) {
+    int16_t a = Gauge_Angle(g, g->value);
+    Gauge_Wedge(g, g->start, g->start + a, g->fg);
+    Gauge_Wedge(g, g->start + a, g->start + g->sweep, g->track);
+    g->shown = a;
+}
+
+// 값 변경: 이전 각도와 새 각도 사이 부채꼴만
+static void Gauge_Set(Gauge_t *g, uint16_t value) {
+    g->value = value;
+    if(g->shown < 0) { Gauge_Draw(g); return; }
+
+    int16_t a = Gauge_Angle(g, value);
+    if(a > g->shown) Gauge_Wedge(g, g->start + g->shown, g->start + a, g->fg);
+    else Gauge_Wedge(g, g->start + a, g->start + g->shown, g->track);
+    g->shown = a;
+}
+
+#define DIGITS_MAX      6
+#define SEG_BLANK       0x00
+#define SEG_MINUS       0x40     // g 세그먼트
+
+// 세그먼트 비트: a=0 (위), b, c, d (아래), e, f, g (가운데)
+static const uint8_t seg_digit[10] = { 0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F };
+
+typedef struct {
+    int16_t x, y;
+    uint8_t digits;
+    uint8_t dw, dh, t, gap;      // 자리 폭 / 높이, 세그먼트 두께, 자리 간격
+    uint16_t fg, bg;
+    uint32_t value;
+    uint8_t shown[DIGITS_MAX];   // 자리별 화면의 세그먼트, 0xFF = 안 그려짐
+} Digits_t;
+
+// 세그먼트 사각형 (뷰포트 좌표, 자리 폭 / 높이는 8비트라 Span_t 에 그대로 들어감)
+static void Digits_Segment(const Digits_t *d, uint8_t pos, uint8_t seg, uint16_t color, Span_t *sp) {
+    int16_t x = d->x + pos * (d->dw + d->gap);
+    int16_t y = d->y;
+    int16_t t = d->t, w = d->dw - 2 * t;
+    int16_t hh = (d->dh - 3 * t) / 2;    // 세로 세그먼트 길이
+
+    sp->color = color;
+    switch(seg) {
+        case 0: sp->x = x + t;         sp->y = y;                  sp->w = w; sp->h = t;  break;
+        case 1: sp->x = x + d->dw - t; sp->y = y + t;              sp->w = t; sp->h = hh; break;
+        case 2: sp->x = x + d->dw - t; sp->y = y + 2 * t + hh;     sp->w = t; sp->h = hh; break;
+        case 3: sp->x = x + t;         sp->y = y + 2 * t + 2 * hh; sp->w = w; sp->h = t;  break;
+        case 4: sp->x = x;             sp->y = y + 2 * t + hh;     sp->w = t; sp->h = hh; break;
+        case 5: sp->x = x;             sp->y = y + t;              sp->w = t; sp->h = hh; break;
+        case 6: sp->x = x + t;         sp->y = y + t + hh;         sp->w = w; sp->h = t;  break;
+    }
+}
+
+// 오른쪽 정렬, 앞자리 0 은 비움, 자리수를 넘으면 전부 '-'
+static void Digits_Masks(const Digits_t *d, uint32_t value, uint8_t *mask) {
+    uint32_t v = value;
+    for(int8_t i = d->digits - 1; i >= 0; i--) {
+        mask[i] = (v || i == d->digits - 1) ? seg_digit[v % 10] : SEG_BLANK;
+        v /= 10;
+    }
+    if(v) memset(mask, SEG_MINUS, d->digits);
+}
+
+static void Digits_Init(Digits_t *d, int16_t x, int16_t y, uint8_t digits, uint8_t dw, uint8_t dh,
+                        uint8_t t, uint8_t gap, uint16_t fg, uint16_t bg) {
+    d->x = x; d->y = y;
+    d->digits = (digits > DIGITS_MAX) ? DIGITS_MAX : digits;
+    d->dw = dw; d->dh = dh; d->t = t; d->gap = gap;
+    d->fg = fg; d->bg = bg;
+    d->value = 0;
+    memset(d->shown, 0xFF, sizeof(d->shown));
+}
+
+// 값 변경: 켜지거나 꺼진 세그먼트만 (처음이면 모든 세그먼트), 자리마다 일괄 그리기 1회
+static void Digits_Set(Digits_t *d, uint32_t value) {
+    uint8_t mask[DIGITS_MAX];
+    d->value = value;
+    Digits_Masks(d, value, mask);
+
+    for(uint8_t i = 0; i < d->digits; i++) {
+        Span_t seg[7];
+        uint8_t n = 0;
+        uint8_t diff = (d->shown[i] == 0xFF) ? 0x7F : (uint8_t)(d->shown[i] ^ mask[i]);
+        for(uint8_t s = 0; s < 7; s++) {
+            if(diff & (1 << s)) Digits_Segment(d, i, s, (mask[i] & (1 << s)) ? d->fg : d->bg, &seg[n++]);
+        }
+        LCD_DrawSpans(seg, n, 0, 0, 0, 0);
+        d->shown[i] = mask[i];
+    }
+}
+
+static void Digits_Draw(Digits_t *d) {
+    memset(d->shown, 0xFF, sizeof(d->shown));
+    Digits_Set(d, d->value);
+}
+
+// 아래쪽 위젯 띠 (widgets 레이어)
+static Bar_t widget_battery;
+static Gauge_t widget_gauge;
+static Digits_t widget_readout;
+
+#define WIDGET_Y        (EYE_AREA_Y + EYE_AREA_H + 22)   // 눈 영역 아래 띠 (가운데 기준)
+
+static void Widgets_Init(void) {
+    Bar_Init(&widget_battery, LCD_W/2 - 108, WIDGET_Y, 64, 18, 0, EYE_COLOR, EYE_BG, 0x8410, 100);
+    Gauge_Init(&widget_gauge, LCD_W/2, WIDGET_Y + 20, 20, 28, 225, 270, EYE_COLOR, EYE_DIM, 100);
+    Digits_Init(&widget_readout, LCD_W/2 + 48, WIDGET_Y, 3, 16, 30, 3, 4, EYE_COLOR, EYE_BG);
+}
+
+// 레이어 다시 그리기용 전체 렌더 (lcd_clip 적용)
+static void Widgets_Render(void) {
+    Bar_Draw(&widget_battery);
+    Gauge_Draw(&widget_gauge);
+    Digits_Draw(&widget_readout);
+}
+
+// ============================================================================
+// 표정 & 애니메이션
+// ============================================================================
+
+// Eye_Normal 계열 표정이면 하이라이트 오프셋을 돌려줌
+static uint8_t Expr_Gaze(Expression_t expr, int16_t ox, int16_t oy, int16_t *gx, int16_t *gy) {
+    switch(expr) {
+        case EXPR_NORMAL:     *gx = ox; *gy = oy; return 1;
+        case EXPR_LOOK_LEFT:  *gx = -EYE_GAZE_MAX; *gy = 0;  return 1;
+        case EXPR_LOOK_RIGHT: *gx = EYE_GAZE_MAX;  *gy = 0;  return 1;
+        case EXPR_LOOK_UP:    *gx = 0;  *gy = -EYE_GAZE_MAX; return 1;
+        case EXPR_LOOK_DOWN:  *gx = 0;  *gy = EYE_GAZE_MAX;  return 1;
+        default: return 0;
+    }
+}
+
+// 방금 그린 하이라이트를 스프라이트로 등록
+static void Glint_Sync(Expression_t expr, int16_t ox, int16_t oy) {
+    int16_t gx, gy;
+    if(!Expr_Gaze(expr, ox, oy, &gx, &gy)) return;
+
+    const int16_t cx[2] = { eye.lx, eye.rx };
+    for(uint8_t i = 0; i < 2; i++) {
+        int16_t sx = EYE_AREA_X + cx[i] - eye.w/2;
+        int16_t sy = EYE_AREA_Y + eye.cy - eye.h/2;
+        Sprite_Init(&eye_glint[i], sx + eye.glint_x + gx, sy + eye.glint_y + gy, eye.glint_r, eye.bright,
+                    sx, sy, eye.w, eye.h, eye.r, eye.color, EYE_BODY_BOT);
+    }
+    gaze_ox = gx;
+    gaze_oy = gy;
+    glint_live = 1;
+}
+
+// 표정 = 눈 모양 조각들 (왼쪽 눈 기준 모양 + 배치 플래그)
+#define PART_R          0x01     // 오른쪽 눈 (RX)
+#define PART_MIRROR     0x02     // 왼쪽 모양을 좌우반전
+#define PART_GAZE       0x04     // 시선 오프셋 적용
+#define EXPR_PARTS_MAX  4
+
+typedef struct {
+    uint8_t shape;
+    uint8_t flags;
+} EyePart_t;
+
+static const EyePart_t expr_parts[][EXPR_PARTS_MAX] = {
+    [EXPR_NORMAL]     = { {SHAPE_BODY, 0}, {SHAPE_GLINT, PART_GAZE},
+                          {SHAPE_BODY, PART_R}, {SHAPE_GLINT, PART_R | PART_GAZE} },
+    [EXPR_HAPPY]      = { {SHAPE_HAPPY, 0}, {SHAPE_HAPPY, PART_R} },
+    [EXPR_SAD]        = { {SHAPE_SAD, 0}, {SHAPE_SAD, PART_R} },
+    [EXPR_ANGRY]      = { {SHAPE_ANGRY, 0}, {SHAPE_ANGRY, PART_R | PART_MIRROR} },
+    [EXPR_SURPRISED]  = { {SHAPE_SURPRISED, 0}, {SHAPE_SURPRISED, PART_R} },
+    [EXPR_SLEEPY]     = { {SHAPE_SLEEPY, 0}, {SHAPE_SLEEPY, PART_R} },
+    [EXPR_WINK_LEFT]  = { {SHAPE_CLOSED, 0}, {SHAPE_BODY, PART_R}, {SHAPE_GLINT, PART_R} },
+    [EXPR_WINK_RIGHT] = { {SHAPE_BODY, 0}, {SHAPE_GLINT, 0}, {SHAPE_CLOSED, PART_R} },
+    [EXPR_BLINK]      = { {SHAPE_CLOSED, 0}, {SHAPE_CLOSED, PART_R} },
+    [EXPR_LOVE]       = { {SHAPE_HEART, 0}, {SHAPE_HEART, PART_R} },
+    [EXPR_DIZZY]      = { {SHAPE_X, 0}, {SHAPE_X, PART_R} },
+    [EXPR_LOOK_LEFT]  = { {SHAPE_BODY, 0}, {SHAPE_GLINT, PART_GAZE},
+                          {SHAPE_BODY, PART_R}, {SHAPE_GLINT, PART_R | PART_GAZE} },
+    [EXPR_LOOK_RIGHT] = { {SHAPE_BODY, 0}, {SHAPE_GLINT, PART_GAZE},
+                          {SHAPE_BODY, PART_R}, {SHAPE_GLINT, PART_R | PART_GAZE} },
+    [EXPR_LOOK_UP]    = { {SHAPE_BODY, 0}, {SHAPE_GLINT, PART_GAZE},
+                          {SHAPE_BODY, PART_R}, {SHAPE_GLINT, PART_R | PART_GAZE} },
+    [EXPR_LOOK_DOWN]  = { {SHAPE_BODY, 0}, {SHAPE_GLINT, PART_GAZE},
+                          {SHAPE_BODY, PART_R}, {SHAPE_GLINT, PART_R | PART_GAZE} },
+};
+
+static void Draw_Part(const EyePart_t *p, int16_t gx, int16_t gy) {
+    int16_t ox = (p->flags & PART_GAZE) ? gx : 0;
+    int16_t oy = (p->flags & PART_GAZE) ? gy : 0;
+
+#if SPAN_CACHE_ENABLE
+    const SpanCacheEntry_t *e = SpanCache_Get(p->shape);
+    if(e) {
+        int16_t dx = ((p->flags & PART_R) ? (eye.rx - eye.lx) : 0) + ox;
+        if(gov.mode & GOV_COARSE)
+            Span_ReplayCoarse(&span_pool[e->start], e->n, dx, oy,
+                              p->flags & PART_MIRROR, 2 * (EYE_AREA_X + eye.lx) - 1);
+        else
+            Span_Replay(&span_pool[e->start], e->n, dx, oy,
+                        p->flags & PART_MIRROR, 2 * (EYE_AREA_X + eye.lx) - 1);
+        return;
+    }
+#endif
+    Shape_Raster(p->shape, (p->flags & PART_R) ? eye.rx : eye.lx, ox, oy, !(p->flags & PART_MIRROR));
+}
+
+// 양쪽 눈 모양만 그림 (배경 지우기 없음, 클립 영역 적용)
+static void Draw_Eyes(Expression_t expr, int16_t ox, int16_t oy) {
+    int16_t gx = 0, gy = 0;
+    Expr_Gaze(expr, ox, oy, &gx, &gy);
+
+    for(uint8_t i = 0; i < EXPR_PARTS_MAX; i++) {
+        const EyePart_t *p = &expr_parts[expr][i];
+        if(p->shape == SHAPE_NONE) break;
+        if((gov.mode & GOV_NO_GLINT) && p->shape == SHAPE_GLINT) continue;
+        Draw_Part(p, gx, gy);
+    }
+}
+
+// 눈 레이어: 마지막으로 요청된 표정을 그림
+static int8_t layer_status = -1, layer_eyes = -1, layer_widgets = -1;
+static Expression_t eye_layer_expr = EXPR_NORMAL;
+static int16_t eye_layer_ox = 0, eye_layer_oy = 0;
+
+static void Eye_LayerRender(void) {
+    Draw_Eyes(eye_layer_expr, eye_layer_ox, eye_layer_oy);
+}
+
+// ============================================================================
+// ★ 프레임 예산 조절기 (예상 비용이 넘치면 디테일 / 프레임 분할) ★
+// ============================================================================
+
+#if TILE_ENABLE
+static uint32_t gov_row_bytes[TILE_ROWS];    // 마지막 추정의 타일 행별 바이트 (띠 경계용)
+
+// 추정용 싱크: 해시가 바뀔 타일에 걸친 부분만 행별로 합산 (구간마다 창 1개)
+static void Gov_CountSpan(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t x1 = x + w - 1, y1 = y + h - 1;
+    uint8_t hit = 0;
+    (void)color;
+    for(int16_t ty = y / TILE_SIZE; ty <= y1 / TILE_SIZE; ty++) {
+        int16_t cy0 = (y > ty * TILE_SIZE) ? y : ty * TILE_SIZE;
+        int16_t cy1 = (y1 < ty * TILE_SIZE + TILE_SIZE - 1) ? y1 : ty * TILE_SIZE + TILE_SIZE - 1;
+        for(int16_t tx = x / TILE_SIZE; tx <= x1 / TILE_SIZE; tx++) {
+            uint16_t th = tile_next[ty][tx] ? tile_next[ty][tx] : 1;
+            if(tile_hash[ty][tx] == th) continue;
+            int16_t cx0 = (x > tx * TILE_SIZE) ? x : tx * TILE_SIZE;
+            int16_t cx1 = (x1 < tx * TILE_SIZE + TILE_SIZE - 1) ? x1 : tx * TILE_SIZE + TILE_SIZE - 1;
+            gov_row_bytes[ty] += 2u * (cx1 - cx0 + 1) * (cy1 - cy0 + 1);
+            if(!hit) gov_row_bytes[ty] += GOV_WINDOW_BYTES;
+            hit = 1;
+        }
+    }
+}
+
+// 눈 레이어를 mode 로 다시 그릴 때 실제로 나갈 예상 버스 바이트 (eye_layer_* 기준)
+// Tile_Paint 와 같게: 화면과 해시가 다른 타일의 배경 + 그 안의 구간만, 버스 전송 없이 렌더러 2회
+static uint32_t Gov_Estimate(uint8_t mode) {
+    const Rect_t *c = &layers[layer_eyes].bounds;
+    uint8_t saved = gov.mode;
+    gov.mode = mode;
+    Tile_Hash(c, EYE_BG, Eye_LayerRender);
+
+    memset(gov_row_bytes, 0, sizeof(gov_row_bytes));
+    SpanList_t sink = { NULL, 0, 0, 0, Gov_CountSpan };
+    span_rec = &sink;
+    LCD_FillRectFast(c->x0, c->y0, c->x1 - c->x0 + 1, c->y1 - c->y0 + 1, EYE_BG);
+    Eye_LayerRender();
+    span_rec = NULL;
+    LCD_ResetClip();
+    gov.mode = saved;
+
+    uint32_t bytes = 0;
+    for(int16_t ty = c->y0 / TILE_SIZE; ty <= c->y1 / TILE_SIZE; ty++) bytes += gov_row_bytes[ty];
+    return bytes;
+}
+#else
+// 타일 없이는 눈 레이어 전체를 다시 그림 (배경 + 캐시 구간)
+static uint32_t Gov_Estimate(uint8_t mode) {
+    uint32_t bytes = GOV_WINDOW_BYTES + (uint32_t)EYE_AREA_W * EYE_AREA_H * 2;
+#if SPAN_CACHE_ENABLE
+    for(uint8_t i = 0; i < EXPR_PARTS_MAX; i++) {
+        const EyePart_t *p = &expr_parts[eye_layer_expr][i];
+        if(p->shape == SHAPE_NONE) break;
+        if((mode & GOV_NO_GLINT) && p->shape == SHAPE_GLINT) continue;
+        const SpanCacheEntry_t *e = SpanCache_Get(p->shape);
+        if(!e) continue;
+
+        const Span_t *sp = &span_pool[e->start];
+        const Span_t *last = NULL;
+        for(uint16_t k = 0; k < e->n; k++, sp++) {
+            uint8_t h = sp->h;
+            if((mode & GOV_COARSE) && !Span_CoarseKeep(sp, &last, &h)) continue;
+            bytes += GOV_WINDOW_BYTES + 2u * sp->w * h;
+        }
+    }
+#else
+    (void)mode;
+#endif
+    return bytes;
+}
+#endif
+
+static void Gov_Report(uint8_t mode, uint8_t bands, uint32_t est) {
+    gov_stats.planned++;
+    gov_stats.last_mode = mode;
+    gov_stats.last_bands = bands;
+    gov_stats.last_est = est;
+    if(mode & GOV_NO_GLINT) gov_stats.no_glint++;
+    if(mode & GOV_COARSE) gov_stats.coarse++;
+    if(mode & GOV_SPLIT) gov_stats.split++;
+}
+
+// 한 프레임에 맞는 가장 가벼운 단계를 고르고 (gov.mode), 나눌 프레임 수 반환
+// 한 프레임에 안 되면 디테일은 살리고 나눔, 최대 분할로도 모자랄 때만 디테일까지 줄임
+// eye_layer_* 는 이미 expr 로 바뀐 상태여야 함 (추정이 눈 레이어 렌더러를 씀)
+static uint8_t Gov_Plan(Expression_t expr) {
+    uint32_t limit = Gov_LimitBytes();
+    uint32_t full = Gov_Estimate(0);
+    uint8_t detail = 0;              // 이 표정에서 줄일 수 있는 디테일
+    for(uint8_t i = 0; i < EXPR_PARTS_MAX; i++) {
+        if(expr_parts[expr][i].shape == SHAPE_GLINT) detail |= GOV_NO_GLINT;
+    }
+#if SPAN_CACHE_ENABLE
+    detail |= GOV_COARSE;
+#endif
+
+    // 그대로 → 하이라이트 생략 → 거친 호 / 선
+    uint8_t mode = 0;
+    uint32_t est = full;
+    if(est > limit && (detail & GOV_NO_GLINT)) {
+        mode |= GOV_NO_GLINT;
+        est = Gov_Estimate(mode);
+    }
+    if(est > limit && (detail & GOV_COARSE)) {
+        mode |= GOV_COARSE;
+        est = Gov_Estimate(mode);
+    }
+    if(est <= limit) {
+        gov.mode = mode;
+        Gov_Report(mode, 1, full);
+        return 1;
+    }
+
+    gov.mode = GOV_SPLIT;
+    if((full + limit - 1) / limit > GOV_SPLIT_MAX) gov.mode |= detail;
+    est = Gov_Estimate(gov.mode);    // 고른 단계로 다시 (띠 경계용 행별 바이트)
+    uint32_t bands = (est + limit - 1) / limit;
+    if(bands > GOV_SPLIT_MAX) {
+        bands = GOV_SPLIT_MAX;
+        gov_stats.over++;
+    }
+    Gov_Report(gov.mode, bands, full);
+    return bands;
+}
+
+// 기본 레이어: 위쪽 상태 표시줄 / 눈 영역 / 아래쪽 위젯
+// 상태 줄 (눈 영역 바로 위, 바뀐 글자만 다시 그림)
+#define STATUS_X        4
+#define STATUS_Y        (EYE_AREA_Y - 12)
+#define STATUS_COLS     38
+#define STATUS_FG       EYE_COLOR
+
+#if HUD_ENABLE && STATUS_Y < HUD_Y + HUD_LINES * GLYPH_H
+#error "Status line overlaps the HUD"
+#endif
+
+static char status_text[STATUS_COLS];     // 보여야 할 글자 (공백 채움)
+static char status_shown[STATUS_COLS];    // 화면에 그려진 글자
+
+// 화면과 다른 글자 묶음마다 LCD_DrawText 1회 (redraw: 레이어 bg 위라 공백만 같은 것으로 봄)
+static inline uint8_t Status_Same(uint8_t c, uint8_t redraw) {
+    return status_text[c] == (redraw ? ' ' : status_shown[c]);
+}
+
+static void Status_Runs(uint8_t redraw) {
+    for(uint8_t c = 0; c < STATUS_COLS; ) {
+        if(Status_Same(c, redraw)) { c++; continue; }
+        uint8_t start = c;
+        while(c < STATUS_COLS && !Status_Same(c, redraw)) c++;
+        LCD_DrawText(STATUS_X + start * GLYPH_W, STATUS_Y, &status_text[start], c - start, STATUS_FG, EYE_BG);
+    }
+    memcpy(status_shown, status_text, sizeof(status_shown));
+}
+
+// 상태 레이어 (HUD 줄 포함) 렌더
+static void Status_Render(void) {
+    Status_Runs(1);
+#if HUD_ENABLE
+    HUD_Redraw();
+#endif
+}
+
+static void Status_SetText(const char *str) {
+    uint8_t n = 0;
+    while(n < STATUS_COLS && str[n]) { status_text[n] = str[n]; n++; }
+    memset(&status_text[n], ' ', STATUS_COLS - n);
+    Status_Runs(0);
+}
+
+static void Layers_Init(void) {
+    Widgets_Init();
+    memset(status_text, ' ', sizeof(status_text));
+    memset(status_shown, ' ', sizeof(status_shown));
+    layer_status  = Layer_Add(0, 0, LCD_W, EYE_AREA_Y, 0, 1, EYE_BG, Status_Render);
+    layer_eyes    = Layer_Add(EYE_AREA_X, EYE_AREA_Y, EYE_AREA_W, EYE_AREA_H, 1, 1, EYE_BG, Eye_LayerRender);
+    layer_widgets = Layer_Add(0, EYE_AREA_Y + EYE_AREA_H, LCD_W, LCD_H - EYE_AREA_Y - EYE_AREA_H, 2, 1, EYE_BG, Widgets_Render);
+    layers[layer_eyes].tiled = TILE_ENABLE;
+}
+
+// 띠 b 의 끝 y: 타일 행별 예상 바이트 누계가 (b+1)/bands 몫에 닿는 행 경계
+static int16_t Gov_BandEnd(uint8_t b, uint8_t bands) {
+    int16_t end = EYE_AREA_Y + EYE_AREA_H;
+    if(b >= bands - 1) return end;
+#if TILE_ENABLE
+    int16_t ty0 = EYE_AREA_Y / TILE_SIZE, ty1 = (end - 1) / TILE_SIZE;
+    uint32_t total = 0, acc = 0;
+    for(int16_t ty = ty0; ty <= ty1; ty++) total += gov_row_bytes[ty];
+    uint32_t goal = total * (b + 1) / bands;
+    for(int16_t ty = ty0; ty < ty1; ty++) {
+        acc += gov_row_bytes[ty];
+        if(acc >= goal) return (ty + 1) * TILE_SIZE;
+    }
+    return end;
+#else
+    return (EYE_AREA_Y + EYE_AREA_H * (b + 1) / bands) & ~(TILE_SIZE - 1);
+#endif
+}
+
+// 다음 띠 하나를 그림 (빈 띠는 건너뜀), 마지막 띠면 표정 마무리
+static void Gov_DrawBand(void) {
+    int16_t y1 = gov.band_y;
+    while(y1 <= gov.band_y && gov.band < gov.bands) y1 = Gov_BandEnd(gov.band++, gov.bands);
+    if(y1 > gov.band_y) Layer_Invalidate(layer_eyes, EYE_AREA_X, gov.band_y, EYE_AREA_W, y1 - gov.band_y);
+    gov.band_y = y1;
+    Compositor_Present();
+    gov.band_tick = HAL_GetTick();
+    if(gov.band < gov.bands) return;
+
+    gov.lost = gov.mode & (GOV_NO_GLINT | GOV_COARSE);
+    eye_shown = !gov.lost;
+    if(!(gov.mode & GOV_NO_GLINT)) Glint_Sync(eye_layer_expr, eye_layer_ox, eye_layer_oy);
+    gov.mode = 0;
+    gov.bands = 0;
+}
+
+// 눈 레이어를 bands 개 띠로 그리기 시작 (첫 띠는 이번 프레임, gov.mode 는 계획된 상태)
+static void Gov_Start(uint8_t bands) {
+    gov.bands = bands;
+    gov.band = 0;
+    gov.band_y = EYE_AREA_Y;
+    Frame_Begin();
+    Gov_DrawBand();
+    Frame_End();
+}
+
+// 예산 초과 시 가로 띠로 나눠 이번 프레임에는 첫 띠만, 나머지는 Gov_Service 가 슬롯마다 하나씩
+// 남은 띠가 있어도 다시 부르면 새 표정으로 처음부터 (그리지 않은 타일의 해시는 화면 그대로)
+static void Draw_Expression(Expression_t expr, int16_t ox, int16_t oy) {
+    glint_live = 0;
+    eye_shown = 0;                   // 마지막 띠까지는 화면이 두 표정 섞임
+    gov.lost = 0;
+    eye_layer_expr = expr;
+    eye_layer_ox = ox;
+    eye_layer_oy = oy;
+
+    Gov_Start(Gov_Plan(expr));
+}
+
+// 애니메이션 대기 루프에서 호출: 분할 중이면 프레임 슬롯이 지날 때마다 다음 띠
+static void Gov_Service(void) {
+    if(!gov.bands || HAL_GetTick() - gov.band_tick < GOV_SLOT_MS) return;
+    Frame_Begin();
+    Gov_DrawBand();
+    Frame_End();
+}
+
+// 화면 전체가 지금 필요할 때: 남은 띠를 한 프레임에 모두 (넘친 만큼 Frame_End 가 놓친 슬롯으로 셈)
+static void Gov_Flush(void) {
+    if(!gov.bands) return;
+    Frame_Begin();
+    while(gov.bands) Gov_DrawBand();
+    Frame_End();
+}
+
+// 예산 때문에 생략한 디테일을 여유 시간에 복원
+// 거친 호가 남았으면 같은 표정을 원래 디테일로 다시 그림: 타일이면 해시가 달라진 타일만,
+// 한 프레임에 안 맞으면 디테일을 줄이지 않고 띠로만 나눔 (남은 띠는 Anim_Hold 가 마저)
+// 최대 분할로도 모자라면 다음 대기로 미룸. 하이라이트만 빠졌으면 하이라이트만 그림
+static void Gov_Repair(void) {
+    if(!gov.lost || gov.bands) return;
+    if(gov.lost & GOV_COARSE) {
+        uint32_t limit = Gov_LimitBytes();
+        uint32_t est = Gov_Estimate(0);      // 띠 경계용 행별 바이트도 이 추정으로
+        uint32_t bands = (est + limit - 1) / limit;
+        if(bands > GOV_SPLIT_MAX) return;
+        if(!bands) bands = 1;
+
+        glint_live = 0;
+        eye_shown = 0;
+        gov.lost = 0;
+        gov.mode = (bands > 1) ? GOV_SPLIT : 0;
+        Gov_Report(gov.mode, (uint8_t)bands, est);
+        Gov_Start((uint8_t)bands);
+        return;
+    }
+
+    int16_t gx = 0, gy = 0;
+    Expr_Gaze(eye_layer_expr, eye_layer_ox, eye_layer_oy, &gx, &gy);
+
+    Frame_Begin();
+    for(uint8_t i = 0; i < EXPR_PARTS_MAX; i++) {
+        const EyePart_t *p = &expr_parts[eye_layer_expr][i];
+        if(p->shape == SHAPE_NONE) break;
+        if(p->shape == SHAPE_GLINT) Draw_Part(p, gx, gy);
+    }
+    gov.lost = 0;
+    eye_shown = 1;
+    Glint_Sync(eye_layer_expr, eye_layer_ox, eye_layer_oy);
+    for(uint8_t i = 0; i < 2; i++) {     // 해시는 하이라이트 없는 화면 기준 → 하이라이트 원 영역만 잊음
+        const Sprite_t *s = &eye_glint[i];
+        Tile_Forget(s->x - s->r, s->y - s->r, s->x + s->r, s->y + s->r);
+    }
+    Frame_End();
+}
+
+// 눈 파라미터 변경 후 현재 표정을 다시 그림 (범위를 벗어나면 0, 변경 없음)
+// 구간 캐시는 다음 그리기에서 파라미터 해시로 한 번만 다시 기록됨
+static uint8_t Eye_SetParams(const EyeParams_t *p) {
+    EyeParams_t q = *p;
+    q.w &= ~1;                       // 짝수 폭: 오른쪽 눈 좌우반전 재생 축이 정수
+    int16_t half = Eye_HalfSpan(&q) + 5;
+
+    if(q.w < 16 || q.h < 16 || q.r < 0 || q.r > EYE_R_MAX) return 0;
+    if(q.r * 2 > q.w || q.r * 2 > q.h - 10) return 0;
+    if(q.glint_r < 1 || q.glint_r > SPRITE_MAX_R) return 0;
+    if(q.glint_x < q.glint_r || q.glint_x + q.glint_r >= q.w) return 0;
+    if(q.glint_y < q.glint_r || q.glint_y + q.glint_r >= q.h) return 0;
+    if(q.lx - half < 0 || q.rx + half > EYE_AREA_W || q.rx - q.lx < half * 2) return 0;
+    if(q.cy - q.h/2 - 10 < 0 || q.cy + q.h/2 + 10 > EYE_AREA_H) return 0;
+
+    if(memcmp(&q, &eye, sizeof(q)) == 0) return 1;
+
+    int16_t ox = 0, oy = 0;
+    if(glint_live && current_expr == EXPR_NORMAL) { ox = gaze_ox; oy = gaze_oy; }
+
+    eye = q;
+    eye_hash = (memcmp(&q, &eye_default, sizeof(q)) == 0) ? 0 : Eye_Hash(&q);
+    Draw_Expression(current_expr, ox, oy);
+    return 1;
+}
+
+// 시선 이동: 하이라이트가 살아 있으면 가장자리만, 아니면 전체 다시 그림
+// 오프셋은 ±EYE_GAZE_MAX 로 자름 (넘으면 하이라이트가 눈 띠 / 다른 레이어로 나감)
+static void Anim_Gaze(int16_t ox, int16_t oy) {
+    if(ox > EYE_GAZE_MAX) ox = EYE_GAZE_MAX;
+    if(ox < -EYE_GAZE_MAX) ox = -EYE_GAZE_MAX;
+    if(oy > EYE_GAZE_MAX) oy = EYE_GAZE_MAX;
+    if(oy < -EYE_GAZE_MAX) oy = -EYE_GAZE_MAX;
+    if(!glint_live) {
+        Draw_Expression(EXPR_NORMAL, ox, oy);
+        return;
+    }
+
+    Frame_Begin();
+    for(uint8_t i = 0; i < 2; i++) {
+        Sprite_t *s = &eye_glint[i];
+        Sprite_MoveTo(s, s->x + ox - gaze_ox, s->y + oy - gaze_oy);
+        Tile_Forget(s->bx, s->by, s->bx + s->bw - 1, s->by + s->bh - 1);
+    }
+    gaze_ox = ox;
+    gaze_oy = oy;
+    eye_layer_expr = EXPR_NORMAL;    // LOOK_* 도 같은 화면
+    eye_layer_ox = ox;
+    eye_layer_oy = oy;
+    Frame_End();
+}
+
+// ============================================================================
+// ★ 저해상도 캔버스 (LCD_W/2 x LCD_H/2, 2bpp 팔레트, 2배 확대 전송) ★
+// ============================================================================
+// 눈 띠 밖까지 쓰는 전체 화면 장면용 프레임버퍼 (240x320 패널에서 120x160 = 4.8KB)
+// 도형은 캔버스에 그리고, 전송할 때 원본 행을 한 번만 펼쳐 패널 두 행에 씀 (가로도 2배)
+// 팔레트 4색은 버스 워드로 미리 인코딩 → 전송 루프는 색 변환 / 비트 분해 없이 store 4번
+// 바뀐 행 범위만 보내고, 팔레트를 바꾸면 전체를 다시 보냄
+
+#if CANVAS_ENABLE                // 스위치는 버스 워드 절에 (팔레트 인코딩이 그쪽에 있음)
+#define CANVAS_W        (LCD_W / 2)
+#define CANVAS_H        (LCD_H / 2)
+#define CANVAS_STRIDE   (CANVAS_W / 4)        // 바이트당 4픽셀, 왼쪽 픽셀이 하위 비트
+
+static uint8_t canvas[CANVAS_H][CANVAS_STRIDE];
+static uint16_t canvas_pal[4];
+static uint32_t canvas_bus[4][6];             // 색별 { 상위 바이트 A, B, C, 하위 바이트 A, B, C }
+static const uint32_t *canvas_line[CANVAS_W]; // 펼친 행 (픽셀별 버스 워드)
+static int16_t canvas_y0 = 0, canvas_y1 = CANVAS_H - 1;    // 보낼 행 범위 (처음엔 전체)
+
+static inline void Canvas_Touch(int16_t y0, int16_t y1) {
+    if(y0 < canvas_y0) canvas_y0 = y0;
+    if(y1 > canvas_y1) canvas_y1 = y1;
+}
+
+static inline void Canvas_Put(uint8_t *row, int16_t x, uint8_t c) {
+    uint8_t sh = (x & 3) * 2;
+    row[x >> 2] = (row[x >> 2] & ~(3 << sh)) | (c << sh);
+}
+
+static void Canvas_SetPalette(uint8_t i, uint16_t color) {
+    if(canvas_pal[i & 3] == color && canvas_bus[i & 3][0]) return;
+    canvas_pal[i & 3] = color;
+    LCD_EncodeBusWords(color >> 8, &canvas_bus[i & 3][0]);
+    LCD_EncodeBusWords(color & 0xFF, &canvas_bus[i & 3][3]);
+    Canvas_Touch(0, CANVAS_H - 1);
+}
+
+static void Canvas_Clear(uint8_t c) {
+    memset(canvas, (c & 3) * 0x55, sizeof(canvas));
+    Canvas_Touch(0, CANVAS_H - 1);
+}
+
+static void Canvas_HLine(int16_t x, int16_t y, int16_t w, uint8_t c) {
+    if(y < 0 || y >= CANVAS_H) return;
+    if(x < 0) { w += x; x = 0; }
+    if(x + w > CANVAS_W) w = CANVAS_W - x;
+    if(w <= 0) return;
+    Canvas_Touch(y, y);
+
+    uint8_t *row = canvas[y];
+    int16_t end = x + w;
+    c &= 3;
+
+    while(x < end && (x & 3)) Canvas_Put(row, x++, c);
+    if(end - x >= 4) {
+        memset(&row[x >> 2], c * 0x55, (end - x) >> 2);
+        x += (end - x) & ~3;
+    }
+    while(x < end) Canvas_Put(row, x++, c);
+}
+
+static void Canvas_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t c) {
+    for(int16_t j = 0; j < h; j++) Canvas_HLine(x, y + j, w, c);
+}
+
+static void Canvas_FillCircle(int16_t x0, int16_t y0, int16_t r, uint8_t c) {
+    int16_t x = r, y = 0;
+    int16_t err = 1 - r;
+
+    while(x >= y) {
+        Canvas_HLine(x0 - x, y0 + y, x * 2 + 1, c);
+        Canvas_HLine(x0 - x, y0 - y, x * 2 + 1, c);
+        Canvas_HLine(x0 - y, y0 + x, y * 2 + 1, c);
+        Canvas_HLine(x0 - y, y0 - x, y * 2 + 1, c);
+
+        y++;
+        if(err < 0) err += 2 * y + 1;
+        else { x--; err += 2 * (y - x + 1); }
+    }
+}
+
+// 바뀐 행 범위를 2배로 전송: 윈도우 1번, 원본 행마다 펼치기 1번 + 패널 2행
+static void Canvas_Present(void) {
+    if(canvas_y0 > canvas_y1) return;
+
+    uint32_t rows = canvas_y1 - canvas_y0 + 1;
+    LCD_SetWindow(0, canvas_y0 * 2, LCD_W - 1, canvas_y1 * 2 + 1);
+
+    LCD_CS_LOW();
+    LCD_RS_HIGH();
+    for(int16_t y = canvas_y0; y <= canvas_y1; y++) {
+        const uint8_t *src = canvas[y];
+        for(int16_t x = 0; x < CANVAS_W; x += 4) {
+            uint8_t b = *src++;
+            canvas_line[x]     = canvas_bus[b & 3];
+            canvas_line[x + 1] = canvas_bus[(b >> 2) & 3];
+            canvas_line[x + 2] = canvas_bus[(b >> 4) & 3];
+            canvas_line[x + 3] = canvas_bus[b >> 6];
+        }
+        for(uint8_t rep = 0; rep < 2; rep++) {
+            for(int16_t x = 0; x < CANVAS_W; x++) {
+                const uint32_t *w = canvas_line[x];
+                LCD_WriteBusWords(w); LCD_WriteBusWords(w + 3);
+                LCD_WriteBusWords(w); LCD_WriteBusWords(w + 3);
+            }
+        }
+    }
+    LCD_CS_HIGH();
+    lcd_bus_bytes += rows * 2 * LCD_W * 2;
+
+    Tile_Forget(0, canvas_y0 * 2, LCD_W - 1, canvas_y1 * 2 + 1);
+    canvas_y0 = CANVAS_H;
+    canvas_y1 = -1;
+}
+
+// 캔버스 장면을 끝내고 레이어 화면을 처음부터 다시 그림
+// 레이어 전체 무효화 (캔버스가 덮었던 화면을 돌려놓을 때)
+static void Layer_InvalidateAll(int8_t id) {
+    if(id < 0 || id >= layer_count) return;
+    Layer_t *l = &layers[id];
+    l->dirty[0] = l->bounds;
+    l->ndirty = 1;
+}
+
+static void Canvas_Leave(void) {
+    Tile_Forget(0, 0, LCD_W - 1, LCD_H - 1);
+    glint_live = 0;
+    Layer_InvalidateAll(layer_status);
+    Layer_InvalidateAll(layer_eyes);
+    Layer_InvalidateAll(layer_widgets);
+    Compositor_Present();
+    // 눈 띠 좌우 여백은 어느 레이어에도 속하지 않음
+    LCD_FillRectFast(0, EYE_AREA_Y, EYE_AREA_X, EYE_AREA_H, EYE_BG);
+    LCD_FillRectFast(EYE_AREA_X + EYE_AREA_W, EYE_AREA_Y, LCD_W - EYE_AREA_X - EYE_AREA_W, EYE_AREA_H, EYE_BG);
+    eye_shown = 1;
+    gov.lost = 0;
+    Glint_Sync(eye_layer_expr, eye_layer_ox, eye_layer_oy);
+    Canvas_Touch(0, CANVAS_H - 1);       // 다음 장면은 전체 전송부터
+}
+#endif
+
+// ============================================================================
+// ★ 다음 표정 미리 계산 (대기 시간 활용) ★
+// ============================================================================
+// 현재 화면과 다음 표정을 캐시 구간으로 한 행씩 합성해 비교하고, 달라지는 구간만 저장
+// 전환 시점에는 저장된 구간 전송만 남음 (래스터화 / 눈 영역 지우기 없음)
+
+#if SPAN_CACHE_ENABLE
+
+#define SPEC_MAX_SPANS  384      // 구간 8바이트 → 3KB, 넘치면 일반 경로
+
+typedef struct {
+    Span_t buf[SPEC_MAX_SPANS];
+    uint16_t n;
+    uint8_t ready;
+    Expression_t from, to;
+    int16_t from_ox, from_oy;
+    uint32_t hash;               // 계산 당시 eye_hash
+} Spec_t;
+
+static Spec_t spec;
+static uint16_t spec_row[2][EYE_AREA_W];    // 0: 현재 화면, 1: 다음 표정
+
+// expr 의 yy 행을 row 에 합성 (Draw_Part 와 같은 배치), 캐시 실패면 0
+static uint8_t Spec_PaintRow(uint16_t *row, int16_t yy, Expression_t expr, int16_t ox, int16_t oy) {
+    int16_t gx = 0, gy = 0;
+    Expr_Gaze(expr, ox, oy, &gx, &gy);
+    for(int16_t x = 0; x < EYE_AREA_W; x++) row[x] = EYE_BG;
+
+    for(uint8_t i = 0; i < EXPR_PARTS_MAX; i++) {
+        const EyePart_t *p = &expr_parts[expr][i];
+        if(p->shape == SHAPE_NONE) break;
+        const SpanCacheEntry_t *e = SpanCache_Get(p->shape);
+        if(!e) return 0;
+
+        uint8_t mirror = p->flags & PART_MIRROR;
+        int16_t mx = 2 * (EYE_AREA_X + eye.lx) - 1;
+        int16_t dx = ((p->flags & PART_R) ? (eye.rx - eye.lx) : 0) + ((p->flags & PART_GAZE) ? gx : 0);
+        int16_t dy = (p->flags & PART_GAZE) ? gy : 0;
+        const Span_t *sp = &span_pool[e->start];
+
+        for(uint16_t k = 0; k < e->n; k++, sp++) {
+            int16_t y = sp->y + dy;
+            if(yy < y || yy >= y + sp->h) continue;
+            int16_t x0 = (mirror ? (mx - (sp->x + sp->w - 1)) : sp->x) + dx - EYE_AREA_X;
+            int16_t x1 = x0 + sp->w;
+            if(x0 < 0) x0 = 0;
+            if(x1 > EYE_AREA_W) x1 = EYE_AREA_W;
+            while(x0 < x1) row[x0++] = sp->color;
+        }
+    }
+    return 1;
+}
+
+// 영역 안 [x0, x1) 구간 추가 (바로 윗행에서 끝나는 같은 구간이면 세로로 늘림), 가득 차면 0
+static uint8_t Spec_Emit(int16_t x0, int16_t x1, int16_t yy, uint16_t color) {
+    int16_t x = EYE_AREA_X + x0;
+    int16_t w = x1 - x0;
+
+    for(int16_t i = spec.n - 1; i >= 0; i--) {
+        Span_t *s = &spec.buf[i];
+        if(s->x == x && s->w == w && s->color == color && s->y + s->h == yy && s->h < 255) {
+            s->h++;
+            return 1;
+        }
+    }
+    if(spec.n >= SPEC_MAX_SPANS) return 0;
+    Span_t *s = &spec.buf[spec.n++];
+    s->x = x; s->y = yy; s->w = w; s->h = 1; s->color = color;
+    return 1;
+}
+
+// 현재 화면 → next (시선 0) 전환을 미리 계산, 실패하면 ready = 0 (일반 경로)
+// t0 부터 ms 안에 끝나야 함: 행마다 확인해서 넘으면 포기 (머무는 시간을 늘리지 않음)
+static void Spec_Prepare(Expression_t next, uint32_t t0, uint32_t ms) {
+    spec.ready = 0;
+    spec.n = 0;
+    if(!eye_shown) return;
+
+    for(int16_t yy = EYE_AREA_Y; yy < EYE_AREA_Y + EYE_AREA_H; yy++) {
+        if(HAL_GetTick() - t0 >= ms) return;
+        if(!Spec_PaintRow(spec_row[0], yy, eye_layer_expr, eye_layer_ox, eye_layer_oy)) return;
+        if(!Spec_PaintRow(spec_row[1], yy, next, 0, 0)) return;
+
+        int16_t x = 0;
+        while(x < EYE_AREA_W) {
+            if(spec_row[0][x] == spec_row[1][x]) { x++; continue; }
+            int16_t x0 = x;
+            uint16_t c = spec_row[1][x];
+            while(x < EYE_AREA_W && spec_row[0][x] != spec_row[1][x] && spec_row[1][x] == c) x++;
+            if(!Spec_Emit(x0, x, yy, c)) return;
+        }
+    }
+
+    spec.from = eye_layer_expr;
+    spec.from_ox = eye_layer_ox;
+    spec.from_oy = eye_layer_oy;
+    spec.to = next;
+    spec.hash = eye_hash;
+    spec.ready = 1;
+}
+
+// 미리 계산한 전환이 지금 화면에 맞으면 전송만 하고 1
+static uint8_t Spec_Commit(Expression_t expr) {
+    uint8_t ok = spec.ready && spec.to == expr && spec.hash == eye_hash && eye_shown &&
+                 spec.from == eye_layer_expr && spec.from_ox == eye_layer_ox && spec.from_oy == eye_layer_oy;
+    spec.ready = 0;
+    if(!ok) return 0;
+
+    // 한 프레임에 안 맞으면 보통 경로 (조절기가 타일 띠로 나눠 프레임마다 하나씩)
+    uint32_t total = 0;
+    for(uint16_t i = 0; i < spec.n; i++) total += GOV_WINDOW_BYTES + 2u * spec.buf[i].w * spec.buf[i].h;
+    if(total > Gov_LimitBytes()) return 0;
+
+    Frame_Begin();
+    glint_live = 0;
+    for(uint16_t i = 0; i < spec.n; i++) {
+        const Span_t *s = &spec.buf[i];
+        LCD_FillRectFast(s->x, s->y, s->w, s->h, s->color);
+        Tile_Forget(s->x, s->y, s->x + s->w - 1, s->y + s->h - 1);
+    }
+    Gov_Report(0, 1, total);
+    gov.lost = 0;
+    eye_layer_expr = expr;
+    eye_layer_ox = 0;
+    eye_layer_oy = 0;
+    Compositor_Present();        // 다른 레이어의 밀린 갱신
+    Glint_Sync(expr, 0, 0);
+    Frame_End();
+    return 1;
+}
+
+#endif
+
+// ms 동안 기다리면서 분할 중인 표정의 남은 띠를 프레임 슬롯마다 그림 (HAL_Delay 대신)
+static void Anim_Wait(uint32_t ms) {
+    uint32_t t0 = HAL_GetTick();
+    while(HAL_GetTick() - t0 < ms) Gov_Service();
+}
+
+// ms 동안 머무르면서 다음 표정 전환을 미리 계산 (남은 띠를 먼저 마저 그림)
+static void Anim_Hold(uint32_t ms, Expression_t next) {
+    uint32_t t0 = HAL_GetTick();
+    while(gov.bands && HAL_GetTick() - t0 < ms) Gov_Service();
+    Gov_Repair();
+    while(gov.bands && HAL_GetTick() - t0 < ms) Gov_Service();   // 복원 띠
+#if SPAN_CACHE_ENABLE
+    Spec_Prepare(next, t0, ms);
+#else
+    (void)next;
+#endif
+    while(HAL_GetTick() - t0 < ms) Gov_Service();
+}
+
+static void Anim_SetExpr(Expression_t expr) {
+    int16_t gx, gy;
+    uint8_t from_gaze = Expr_Gaze(current_expr, 0, 0, &gx, &gy);
+
+    current_expr = expr;
+    if(glint_live && from_gaze && Expr_Gaze(expr, 0, 0, &gx, &gy)) {
+        Anim_Gaze(gx, gy);    // NORMAL <-> LOOK_* 는 하이라이트만 이동
+        return;
+    }
+#if SPAN_CACHE_ENABLE
+    if(Spec_Commit(expr)) return;  // Anim_Hold 에서 미리 계산한 전환
+#endif
+    Draw_Expression(expr, 0, 0);
+}
+
+// ★ 눈꺼풀 깜빡임: 눈꺼풀 경계가 지나간 행만 칠함 ★
+#define BLINK_STEPS     8        // 감기 / 뜨기 각각 단계 수
+#define BLINK_STEP_MS   16       // 단계당 약 60fps
+#define LID_HALF_W      (Eye_HalfSpan(&eye) + 5)    // 눈 중심 기준 눈꺼풀 띠 반폭
+#define LID_TOP         (EYE_AREA_Y + eye.cy - eye.h/2 - 10)
+#define LID_BOT         (EYE_AREA_Y + eye.cy + eye.h/2 + 10)
+
+// 경계 위치 (ease-in-out, /256)
+static const uint16_t lid_ease[BLINK_STEPS + 1] = { 0, 10, 38, 80, 128, 176, 218, 246, 256 };
+
+static inline int16_t Lid_Edge(uint8_t step) {
+    return LID_TOP + (int16_t)(((int32_t)(LID_BOT - LID_TOP) * lid_ease[step]) >> 8);
+}
+
+// [y0, y1) 행을 양쪽 눈 띠에서 EYE_BG 로 덮음
+static void Lid_Cover(int16_t y0, int16_t y1) {
+    if(y1 <= y0) return;
+    LCD_FillRectFast(EYE_AREA_X + eye.lx - LID_HALF_W, y0, LID_HALF_W * 2 + 1, y1 - y0, EYE_BG);
+    LCD_FillRectFast(EYE_AREA_X + eye.rx - LID_HALF_W, y0, LID_HALF_W * 2 + 1, y1 - y0, EYE_BG);
+    Tile_Forget(EYE_AREA_X + eye.lx - LID_HALF_W, y0, EYE_AREA_X + eye.rx + LID_HALF_W, y1 - 1);
+}
+
+// [y0, y1) 행만 다시 지우고 현재 표정을 클립해서 복원
+static void Lid_Uncover(int16_t y0, int16_t y1, int16_t ox, int16_t oy) {
+    if(y1 <= y0) return;
+    Lid_Cover(y0, y1);
+    LCD_SetClip(EYE_AREA_X, y0, EYE_AREA_X + EYE_AREA_W - 1, y1 - 1);
+    Draw_Eyes(current_expr, ox, oy);
+    LCD_ResetClip();
+}
+
+static void Lid_Pace(uint32_t t0) {
+    while(HAL_GetTick() - t0 < BLINK_STEP_MS) {}
+}
+
+static void Anim_Blink(void) {
+    int16_t ox = 0, oy = 0;
+    Gov_Flush();                     // 눈꺼풀 띠 밖은 다시 그리지 않음
+    if(glint_live && current_expr == EXPR_NORMAL) { ox = gaze_ox; oy = gaze_oy; }
+    glint_live = 0;
+    eye_shown = 0;
+
+    int16_t edge = LID_TOP;
+    for(uint8_t i = 1; i <= BLINK_STEPS; i++) {
+        uint32_t t0 = HAL_GetTick();
+        Frame_Begin();
+        int16_t ne = Lid_Edge(i);
+        Lid_Cover(edge, ne);
+        edge = ne;
+        Frame_End();
+        Lid_Pace(t0);
+    }
+
+    Frame_Begin();
+    Eye_Closed(eye.lx);
+    Eye_Closed(eye.rx);
+    Frame_End();
+    HAL_Delay(40);
+
+    // 감은 선 지우기 (경계 아래쪽은 뜨면서 복원됨)
+    LCD_FillRectFast(EYE_AREA_X + eye.lx - eye.w/2 + 5, EYE_AREA_Y + eye.cy - 3, eye.w - 10, 7, EYE_BG);
+    LCD_FillRectFast(EYE_AREA_X + eye.rx - eye.w/2 + 5, EYE_AREA_Y + eye.cy - 3, eye.w - 10, 7, EYE_BG);
+
+    for(int8_t i = BLINK_STEPS - 1; i >= 0; i--) {
+        uint32_t t0 = HAL_GetTick();
+        Frame_Begin();
+        int16_t ne = Lid_Edge(i);
+        Lid_Uncover(ne, edge, ox, oy);
+        edge = ne;
+        Frame_End();
+        Lid_Pace(t0);
+    }
+
+    eye_layer_expr = current_expr;
+    eye_layer_ox = ox;
+    eye_layer_oy = oy;
+    eye_shown = 1;
+    gov.lost = 0;                    // 눈 띠 전체를 원래 디테일로 다시 그렸음
+    Glint_Sync(current_expr, ox, oy);
+}
+
+static void Anim_WinkL(void) {
+    Gov_Flush();
+    Frame_Begin();
+    Eye_Clear();
+    Eye_Closed(eye.lx);
+    Eye_Normal(eye.rx, 0, 0);
+    Frame_End();
+    HAL_Delay(180);
+    Draw_Expression(EXPR_NORMAL, 0, 0);
+}
+
+static void Anim_WinkR(void) {
+    Gov_Flush();
+    Frame_Begin();
+    Eye_Clear();
+    Eye_Normal(eye.lx, 0, 0);
+    Eye_Closed(eye.rx);
+    Frame_End();
+    HAL_Delay(180);
+    Draw_Expression(EXPR_NORMAL, 0, 0);
 }
 
 static void Anim_LookAround(void) {
     Anim_SetExpr(EXPR_LOOK_LEFT);
-    HAL_Delay(280);
+    Anim_Wait(280);
     Anim_SetExpr(EXPR_NORMAL);
-    HAL_Delay(80);
+    Anim_Wait(80);
     Anim_SetExpr(EXPR_LOOK_RIGHT);
-    HAL_Delay(280);
+    Anim_Wait(280);
     Anim_SetExpr(EXPR_NORMAL);
 }
 
@@ -562,8 +3137,8 @@ static void Anim_Idle(void) {
 
     if(t - last_action > 6000 + (rand() % 4000)) {
         switch(rand() % 5) {
-            case 0: Anim_SetExpr(EXPR_LOOK_LEFT); HAL_Delay(300); break;
-            case 1: Anim_SetExpr(EXPR_LOOK_RIGHT); HAL_Delay(300); break;
+            case 0: Anim_SetExpr(EXPR_LOOK_LEFT); Anim_Wait(300); break;
+            case 1: Anim_SetExpr(EXPR_LOOK_RIGHT); Anim_Wait(300); break;
             case 2: Anim_WinkL(); break;
             case 3: Anim_WinkR(); break;
             case 4: Anim_LookAround(); break;
@@ -573,19 +3148,562 @@ static void Anim_Idle(void) {
     }
 }
 
+// 흥분: 잠깐 눈을 키웠다가 되돌림 (모양은 파라미터 해시로 한 번씩만 다시 기록)
+static void Anim_Excited(void) {
+    EyeParams_t p = eye_default;
+    p.w += 10;
+    p.h += 10;
+    p.r += 2;
+    Eye_SetParams(&p);
+    Anim_Wait(800);
+    Eye_SetParams(&eye_default);
+}
+
+#define WIDGET_SLIDE_FRAMES 12
+
+// 위젯 띠를 오른쪽 화면 밖에서 밀어 넣음 (30Hz, 감속)
+// 레이어 영역으로 클립을 잡고 뷰포트 원점만 옮겨 Widgets_Render 를 그대로 씀
+static void Anim_WidgetsSlide(void) {
+    if(layer_widgets < 0) return;
+    const Rect_t *b = &layers[layer_widgets].bounds;
+    int16_t w = b->x1 - b->x0 + 1, h = b->y1 - b->y0 + 1;
+
+    for(uint8_t i = 1; i <= WIDGET_SLIDE_FRAMES; i++) {
+        uint32_t t0 = HAL_GetTick();
+        int16_t r = WIDGET_SLIDE_FRAMES - i;
+        int16_t dx = (int16_t)((int32_t)LCD_W * r * r / (WIDGET_SLIDE_FRAMES * WIDGET_SLIDE_FRAMES));
+        Frame_Begin();
+        LCD_PushClip(b->x0, b->y0, w, h);
+        LCD_FillRectFast(b->x0, b->y0, w, h, layers[layer_widgets].bg);
+        LCD_PushView(dx, 0, LCD_W, LCD_H);
+        Widgets_Render();
+        LCD_PopView();
+        LCD_PopView();
+        Frame_End();
+        while(HAL_GetTick() - t0 < 33) {}
+    }
+}
+
+// 위젯 값 훑기 (30Hz, 바뀐 만큼만 전송)
+static void Anim_Widgets(void) {
+    widget_battery.value = 100;
+    widget_gauge.value = 0;
+    widget_readout.value = 0;
+    Anim_WidgetsSlide();
+    for(uint16_t i = 0; i <= 30; i++) {
+        uint32_t t0 = HAL_GetTick();
+        uint16_t v = (i <= 15) ? (i * 100 / 15) : ((30 - i) * 100 / 15);
+        Frame_Begin();
+        Bar_Set(&widget_battery, 100 - v);
+        Gauge_Set(&widget_gauge, v);
+        Digits_Set(&widget_readout, v);
+        Frame_End();
+        while(HAL_GetTick() - t0 < 33) {}
+    }
+}
+
+#if CANVAS_ENABLE
+// 캔버스 장면: 화면 전체를 튀어 다니는 공 (바뀐 행 범위만 전송)
+// 전송 바이트당 사이클이 보통 그리기와 달라 Frame_End (조절기 보정) 는 쓰지 않음
+static void Anim_Canvas(void) {
+    typedef struct { int16_t x, y, vx, vy, r; uint8_t c; } Ball_t;
+    Ball_t balls[4] = {
+        { 20, 30, 2, 1, 10, 2 }, { 90, 60, -1, 2, 7, 3 },
+        { 60, 120, 1, -2, 12, 1 }, { 30, 100, -2, -1, 5, 3 }
+    };
+
+    Canvas_SetPalette(0, EYE_BG);
+    Canvas_SetPalette(1, EYE_DIM);
+    Canvas_SetPalette(2, EYE_COLOR);
+    Canvas_SetPalette(3, EYE_BRIGHT);
+    Canvas_Clear(0);
+
+    for(uint16_t f = 0; f < 150; f++) {
+        uint32_t t0 = HAL_GetTick();
+        for(uint8_t i = 0; i < 4; i++) {
+            Ball_t *b = &balls[i];
+            Canvas_FillCircle(b->x, b->y, b->r, 0);
+            b->x += b->vx;
+            b->y += b->vy;
+            if(b->x - b->r < 0 || b->x + b->r >= CANVAS_W) b->vx = -b->vx;
+            if(b->y - b->r < 0 || b->y + b->r >= CANVAS_H) b->vy = -b->vy;
+        }
+        for(uint8_t i = 0; i < 4; i++) Canvas_FillCircle(balls[i].x, balls[i].y, balls[i].r, balls[i].c);
+        Canvas_Present();
+        while(HAL_GetTick() - t0 < 33) {}
+    }
+    Canvas_Leave();
+}
+#endif
+
 static void Anim_Demo(void) {
-    Anim_SetExpr(EXPR_NORMAL);    HAL_Delay(1000);
-    Anim_Blink();                  HAL_Delay(500);
-    Anim_SetExpr(EXPR_HAPPY);     HAL_Delay(1000);
-    Anim_SetExpr(EXPR_SAD);       HAL_Delay(1000);
-    Anim_SetExpr(EXPR_ANGRY);     HAL_Delay(1000);
-    Anim_SetExpr(EXPR_SURPRISED); HAL_Delay(1000);
-    Anim_WinkL();                  HAL_Delay(400);
-    Anim_WinkR();                  HAL_Delay(400);
-    Anim_SetExpr(EXPR_LOVE);      HAL_Delay(1000);
-    Anim_SetExpr(EXPR_SLEEPY);    HAL_Delay(1000);
-    Anim_SetExpr(EXPR_DIZZY);     HAL_Delay(1000);
-    Anim_LookAround();             HAL_Delay(500);
+    Anim_SetExpr(EXPR_NORMAL);    Anim_Wait(1000);
+    Anim_Blink();                  Anim_Wait(500);
+    Anim_SetExpr(EXPR_HAPPY);     Anim_Wait(1000);
+    Anim_Excited();                Anim_Hold(300, EXPR_SAD);
+    Anim_SetExpr(EXPR_SAD);       Anim_Hold(1000, EXPR_ANGRY);
+    Anim_SetExpr(EXPR_ANGRY);     Anim_Hold(1000, EXPR_SURPRISED);
+    Anim_SetExpr(EXPR_SURPRISED); Anim_Wait(1000);
+    Anim_WinkL();                  Anim_Wait(400);
+    Anim_WinkR();                  Anim_Wait(400);
+    Anim_SetExpr(EXPR_LOVE);      Anim_Hold(1000, EXPR_SLEEPY);
+    Anim_SetExpr(EXPR_SLEEPY);    Fade_To(FADE_SLEEP, 500);
+    Anim_Hold(300, EXPR_DIZZY);    Fade_To(255, 200);
+    Anim_SetExpr(EXPR_DIZZY);     Anim_Hold(1000, EXPR_LOOK_LEFT);
+    Anim_LookAround();             Anim_Wait(500);
+    Anim_Widgets();                Anim_Wait(300);
+#if CANVAS_ENABLE
+    Anim_Canvas();                 Anim_Wait(300);
+#endif
+}
+
+// ============================================================================
+// ★ 대기 모드 (얼굴을 GRAM 에 남긴 채 패널 SLPIN + MCU 대기) ★
+// ============================================================================
+// 대기 진입 때 화면의 장면 (표정 / 시선 / 페이드 단계) 을 백업 레지스터에 기록
+// 깨어나면 (NRST / RTC 알람) 보통 부팅 경로 → LCD_Resume 이 웜이면 Park_Restore 가
+// 기록된 장면으로 타일 해시만 다시 채움 (버스 전송 없음) → 다음 표정은 바뀐 타일만 전송
+
+#if PARK_ENABLE
+#define PARK_MAGIC      0xE7E5   // BKP DR1: 장면 기록 있음
+
+static uint32_t park_tick = 0;   // 마지막 명령 시각
+
+static void Park_BkpAccess(void) {
+    __HAL_RCC_PWR_CLK_ENABLE();
+    __HAL_RCC_BKP_CLK_ENABLE();
+    HAL_PWR_EnableBkUpAccess();
+}
+
+// 웜 부팅 (Layers_Init 뒤): 반환 1 = 눈 영역을 그대로 이어받음 (첫 표정 그리기 생략)
+static uint8_t Park_Restore(void) {
+    Park_BkpAccess();
+    uint8_t saved = (BKP->DR1 == PARK_MAGIC);
+    uint16_t scene = BKP->DR2, gaze = BKP->DR3;
+    BKP->DR1 = 0;                // 한 번만 (실행 중 리셋이면 기록 없음)
+
+    // 상태 줄 / 위젯은 화면 내용을 모름 → 다음 갱신에서 전부 다시 씀 (위젯은 shown = -1)
+    memset(status_shown, 0, sizeof(status_shown));
+
+    if(!saved) {
+        fade_level = 0;          // 페이드 단계 모름 → 밝음 세트를 다시 씀
+        LCD_SetFade(255);
+        return 0;
+    }
+    fade_level = scene >> 8;     // 감마 / 전원 레지스터는 대기 전 값 그대로
+    if((scene & 0xFF) > EXPR_LOOK_DOWN) return 0;
+
+    current_expr = eye_layer_expr = (Expression_t)(scene & 0xFF);
+    eye_layer_ox = (int8_t)gaze;
+    eye_layer_oy = (int8_t)(gaze >> 8);
+    Tile_Assume(&layers[layer_eyes].bounds, EYE_BG, Eye_LayerRender);
+    eye_shown = 1;
+    Glint_Sync(eye_layer_expr, eye_layer_ox, eye_layer_oy);
+    return 1;
+}
+
+#if PARK_IDLE_MS
+// DR2: [7:0] 표정 (0xFF = 모름), [15:8] fade_level / DR3: 시선 x, y (int8)
+static void Park_Save(void) {
+    uint8_t known = eye_shown && eye_hash == 0;   // 화면 = eye_layer_* 이고 기본 파라미터
+
+    Park_BkpAccess();
+    BKP->DR2 = (known ? (uint8_t)eye_layer_expr : 0xFF) | ((uint16_t)fade_level << 8);
+    BKP->DR3 = (uint8_t)eye_layer_ox | ((uint16_t)(uint8_t)eye_layer_oy << 8);
+    BKP->DR1 = PARK_MAGIC;
+}
+
+// 장면 기록 → 패널 SLPIN → MCU 대기 (돌아오지 않음, 깨어나면 main 부터)
+static void Power_Standby(void) {
+    Park_Save();
+    LCD_Park();
+    HAL_PWR_EnterSTANDBYMode();
+}
+#endif
+#endif
+
+// ============================================================================
+// ★ 이벤트 큐 (ISR → 렌더러, lock-free) ★
+// ============================================================================
+// 여러 ISR 이 동시에 게시 가능 (LDREX/STREX 로 슬롯 예약, 슬롯별 시퀀스로 공개)
+// 렌더러는 프레임 경계에서만 Evt_Dispatch() 로 꺼내므로 그리는 도중 끊기지 않음
+// 큰 채우기의 슬라이스 사이 (lcd_poll) 에서는 Evt_Poll() 이 그리지 않는 이벤트 (밝기) 만 처리
+
+#define EVT_QUEUE_SIZE  16       // 2의 거듭제곱
+#define EVT_QUEUE_MASK  (EVT_QUEUE_SIZE - 1)
+#define EVT_POLL_US     250      // 큰 채우기 중에도 밝기 이벤트를 꺼내는 간격 (채우기 슬라이스 예산)
+
+typedef enum {
+    EVT_EXPR = 1,                // arg: Expression_t
+    EVT_BLINK,
+    EVT_WINK_L,
+    EVT_WINK_R,
+    EVT_LOOK_AROUND,
+    EVT_TEXT,                    // 상태 줄 = uart_text
+    EVT_BRIGHT                   // arg: 밝기 0..255
+} EventType_t;
+
+typedef enum {
+    EVT_PRIO_HIGH = 0,           // 먼저 처리 (충돌, 소리 등)
+    EVT_PRIO_NORMAL,
+    EVT_PRIO_COUNT
+} EventPrio_t;
+
+// 이벤트 워드: [31] 응답 필요, [30:24] type, [23:16] 시리얼 seq, [15:0] arg
+#define EVT_REPLY               0x80000000u
+#define EVT_WORD(type, arg)     (((uint32_t)(type) << 24) | ((uint16_t)(arg)))
+#define EVT_WORD_SEQ(type, seq, arg) (EVT_REPLY | EVT_WORD(type, arg) | ((uint32_t)(uint8_t)(seq) << 16))
+#define EVT_TYPE(w)             ((uint8_t)((w) >> 24) & 0x7F)
+#define EVT_SEQ(w)              ((uint8_t)((w) >> 16))
+#define EVT_ARG(w)              ((uint16_t)(w))
+
+typedef struct {
+    volatile uint32_t seq[EVT_QUEUE_SIZE];   // 슬롯 상태 (pos+1: 데이터 있음, pos+SIZE: 비어 있음)
+    uint32_t word[EVT_QUEUE_SIZE];
+    uint32_t stamp[EVT_QUEUE_SIZE];          // 게시 시점 사이클
+    volatile uint32_t head;                  // 생산자 예약 위치 (ISR 들)
+    uint32_t tail;                           // 소비자 위치 (렌더러만)
+    volatile uint32_t dropped;               // 가득 차서 버린 이벤트
+} EvtRing_t;
+
+typedef struct {
+    uint32_t count;              // 처리한 이벤트 수
+    uint32_t last_us;            // 마지막 이벤트 → 프레임 완료 지연
+    uint32_t max_us;             // 최대 지연
+} EvtStats_t;
+
+static EvtRing_t evt_ring[EVT_PRIO_COUNT];
+static EvtStats_t evt_stats;
+
+// 시선 목표는 큐 대신 최신값 우편함 (새 값이 대기 중인 값을 덮어씀)
+// [31] 유효, [30] 응답 필요, [23:16] 시리얼 seq, [15:8] ox, [7:0] oy (int8)
+#define GAZE_MAIL_VALID     0x80000000u
+#define GAZE_MAIL_REPLY     0x40000000u
+static volatile uint32_t gaze_mail = 0;
+static volatile uint32_t gaze_mail_stamp = 0;
+
+static void Evt_Init(void) {
+    for(uint8_t p = 0; p < EVT_PRIO_COUNT; p++) {
+        for(uint32_t i = 0; i < EVT_QUEUE_SIZE; i++) evt_ring[p].seq[i] = i;
+        evt_ring[p].head = 0;
+        evt_ring[p].tail = 0;
+        evt_ring[p].dropped = 0;
+    }
+    gaze_mail = 0;
+}
+
+static void Evt_AtomicInc(volatile uint32_t *v) {
+    uint32_t x;
+    do { x = __LDREXW(v); } while(__STREXW(x + 1, v));
+}
+
+// ISR / 메인 어디서든 호출 가능, 가득 차면 0
+static uint8_t Evt_PostWord(uint32_t word, EventPrio_t prio) {
+    EvtRing_t *q = &evt_ring[prio];
+    uint32_t pos;
+
+    do {
+        pos = __LDREXW(&q->head);
+        if(q->seq[pos & EVT_QUEUE_MASK] != pos) {
+            __CLREX();
+            Evt_AtomicInc(&q->dropped);
+            return 0;
+        }
+    } while(__STREXW(pos + 1, &q->head));
+
+    uint32_t i = pos & EVT_QUEUE_MASK;
+    q->word[i] = word;
+    q->stamp[i] = Perf_Cycles();
+    __DMB();
+    q->seq[i] = pos + 1;         // 공개
+    return 1;
+}
+
+static inline uint8_t Evt_Post(EventType_t type, uint16_t arg, EventPrio_t prio) {
+    return Evt_PostWord(EVT_WORD(type, arg), prio);
+}
+
+static inline uint8_t Evt_PostExpr(Expression_t expr, EventPrio_t prio) {
+    return Evt_Post(EVT_EXPR, expr, prio);
+}
+
+// 시선 목표: 대기 중인 목표가 있으면 교체 (합치기), 밀려난 값 반환
+// 시각은 LDREX 와 STREX 사이에 씀 → 그 사이 다른 게시 / 소비가 끼면 STREX 가 실패해 둘 다 다시 씀
+static inline uint32_t Evt_PostGazeMail(uint32_t mail) {
+    uint32_t old, now = Perf_Cycles();
+    do {
+        old = __LDREXW(&gaze_mail);
+        gaze_mail_stamp = now;
+        __DMB();
+    } while(__STREXW(mail, &gaze_mail));
+    return old;
+}
+
+// 렌더러 전용
+static uint8_t Evt_Pop(EvtRing_t *q, uint32_t *word, uint32_t *stamp) {
+    uint32_t i = q->tail & EVT_QUEUE_MASK;
+    if(q->seq[i] != q->tail + 1) return 0;   // 비었거나 아직 쓰는 중
+    __DMB();
+    *word = q->word[i];
+    *stamp = q->stamp[i];
+    __DMB();
+    q->seq[i] = q->tail + EVT_QUEUE_SIZE;    // 다음 바퀴용으로 비움
+    q->tail++;
+    return 1;
+}
+
+// 꺼내지 않고 맨 앞 이벤트만 봄 (소비자는 렌더러 하나)
+static uint8_t Evt_Peek(const EvtRing_t *q, uint32_t *word) {
+    uint32_t i = q->tail & EVT_QUEUE_MASK;
+    if(q->seq[i] != q->tail + 1) return 0;
+    __DMB();
+    *word = q->word[i];
+    return 1;
+}
+
+static uint32_t Evt_Latency(uint32_t stamp) {
+    uint32_t us = Perf_CyclesToUs(Perf_Cycles() - stamp);
+    evt_stats.count++;
+    evt_stats.last_us = us;
+    if(us > evt_stats.max_us) evt_stats.max_us = us;
+    return us;
+}
+
+// ============================================================================
+// ★ 시리얼 명령 프로토콜 (USART2: PA2 = TX, PA3 = RX) ★
+// ============================================================================
+// 프레임 형식은 eye_proto.h. 수신 인터럽트가 바이트마다 파서를 돌리고, 완성된 명령은
+// 마지막 바이트가 들어온 순간 이벤트 큐에 게시 (Evt_Post 가 수신 시각을 찍음)
+// → 바이트 링 없이 이벤트 링이 곧 수신 링. 프레임 완료 후 지연(us)을 담아 응답
+
+#ifndef UART_ENABLE
+#define UART_ENABLE     0        // 1: 시리얼 제어 모드, 0: 데모 반복
+#endif
+#define UART_BAUD       115200
+#define UART_IRQ_PRIO   2
+#define UART_TX_SIZE    128      // 2의 거듭제곱 (응답 10바이트 x 12)
+#define UART_TX_MASK    (UART_TX_SIZE - 1)
+
+#if UART_ENABLE
+
+typedef struct {
+    uint32_t commands;           // 큐에 넣은 명령
+    uint32_t rejected;           // 오류 응답을 보낸 명령
+    uint32_t overruns;           // 수신 오버런 (바이트 유실)
+    uint32_t tx_dropped;         // 송신 링이 가득 차 버린 응답
+} UartStats_t;
+
+static Proto_Parser_t uart_rx;                   // ISR 전용
+static uint8_t uart_tx[UART_TX_SIZE];
+static volatile uint16_t uart_tx_head = 0;       // 쓰는 쪽 (메인 / ISR, 인터럽트 잠금)
+static volatile uint16_t uart_tx_tail = 0;       // 읽는 쪽 (TXE 인터럽트)
+static char uart_text[PROTO_MAX_PAYLOAD + 1];    // 마지막 TEXT (ISR 씀, 인터럽트 잠그고 읽음)
+static UartStats_t uart_stats;
+
+static void Uart_Init(void) {
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    __HAL_RCC_USART2_CLK_ENABLE();
+
+    GPIO_InitStruct.Pin = GPIO_PIN_2;            // TX
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = GPIO_PIN_3;            // RX
+    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    Proto_Init(&uart_rx, PROTO_SYNC);
+    USART2->BRR = (HAL_RCC_GetPCLK1Freq() + UART_BAUD / 2) / UART_BAUD;
+    USART2->CR1 = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE | USART_CR1_RXNEIE;
+    NVIC_SetPriority(USART2_IRQn, UART_IRQ_PRIO);
+    NVIC_EnableIRQ(USART2_IRQn);
+}
+
+// 응답 한 프레임을 송신 링에 넣음 (메인 / ISR 공용, 자리 없으면 버림)
+static void Uart_Reply(uint8_t cmd, uint8_t seq, uint8_t status, uint32_t latency_us) {
+    uint8_t buf[PROTO_REPLY_LEN];
+    uint8_t n = (uint8_t)Proto_EncodeReply(buf, cmd, seq, status, latency_us);
+
+    uint32_t pm = __get_PRIMASK();
+    __disable_irq();
+    if((uint16_t)(uart_tx_head - uart_tx_tail) > UART_TX_SIZE - n) {
+        uart_stats.tx_dropped++;
+    } else {
+        for(uint8_t i = 0; i < n; i++) uart_tx[uart_tx_head++ & UART_TX_MASK] = buf[i];
+        USART2->CR1 |= USART_CR1_TXEIE;
+    }
+    __set_PRIMASK(pm);
+}
+
+// 완성된 명령 처리 (ISR 에서 호출) - 검사 후 이벤트로 게시, 실패는 바로 응답
+static void Uart_Command(const Proto_Frame_t *f) {
+    uint8_t st = Proto_Check(f);
+    uint8_t seq = f->seq;
+
+    if(st == PROTO_OK) {
+        switch(f->cmd) {
+            case PROTO_CMD_PING:
+                Uart_Reply(PROTO_CMD_PING, seq, PROTO_OK, 0);
+                return;
+            case PROTO_CMD_EXPR:
+                if(f->payload[0] > EXPR_LOOK_DOWN) st = PROTO_ERR_ARG;
+                else if(!Evt_PostWord(EVT_WORD_SEQ(EVT_EXPR, seq, f->payload[0]), EVT_PRIO_NORMAL)) st = PROTO_ERR_BUSY;
+                break;
+            case PROTO_CMD_GAZE: {
+                if(abs((int8_t)f->payload[0]) > EYE_GAZE_MAX || abs((int8_t)f->payload[1]) > EYE_GAZE_MAX) {
+                    st = PROTO_ERR_ARG;
+                    break;
+                }
+                uint32_t old = Evt_PostGazeMail(GAZE_MAIL_VALID | GAZE_MAIL_REPLY | ((uint32_t)seq << 16) |
+                                                ((uint32_t)f->payload[0] << 8) | f->payload[1]);
+                if((old & GAZE_MAIL_VALID) && (old & GAZE_MAIL_REPLY))
+                    Uart_Reply(PROTO_CMD_GAZE, (uint8_t)(old >> 16), PROTO_REPLACED, 0);
+                break;
+            }
+            case PROTO_CMD_BLINK: {
+                static const uint8_t blink_evt[3] = { EVT_BLINK, EVT_WINK_L, EVT_WINK_R };
+                if(!Evt_PostWord(EVT_WORD_SEQ(blink_evt[f->payload[0]], seq, 0), EVT_PRIO_NORMAL)) st = PROTO_ERR_BUSY;
+                break;
+            }
+            case PROTO_CMD_TEXT:
+                // 대기 중인 TEXT 가 있으면 내용은 최신 것으로 (둘 다 최신 글자를 보여주고 응답)
+                memcpy(uart_text, f->payload, f->len);
+                uart_text[f->len] = '\0';
+                if(!Evt_PostWord(EVT_WORD_SEQ(EVT_TEXT, seq, 0), EVT_PRIO_NORMAL)) st = PROTO_ERR_BUSY;
+                break;
+            case PROTO_CMD_BRIGHT:
+                if(!Evt_PostWord(EVT_WORD_SEQ(EVT_BRIGHT, seq, f->payload[0]), EVT_PRIO_NORMAL)) st = PROTO_ERR_BUSY;
+                break;
+        }
+    }
+
+    if(st == PROTO_OK) {
+        uart_stats.commands++;
+    } else {
+        uart_stats.rejected++;
+        Uart_Reply(f->cmd, seq, st, 0);
+    }
+}
+
+void USART2_IRQHandler(void) {
+    uint32_t sr = USART2->SR;
+
+    if(sr & (USART_SR_RXNE | USART_SR_ORE)) {
+        uint8_t b = (uint8_t)USART2->DR;         // SR → DR 읽기로 오류 플래그도 지워짐
+        if(sr & USART_SR_ORE) uart_stats.overruns++;
+        switch(Proto_Feed(&uart_rx, b)) {
+            case PROTO_FRAME: Uart_Command(&uart_rx.frame); break;
+            case PROTO_BAD:   Uart_Reply(uart_rx.frame.cmd, uart_rx.frame.seq, uart_rx.error, 0); break;
+        }
+    }
+
+    if((sr & USART_SR_TXE) && (USART2->CR1 & USART_CR1_TXEIE)) {
+        if(uart_tx_tail != uart_tx_head) USART2->DR = uart_tx[uart_tx_tail++ & UART_TX_MASK];
+        else USART2->CR1 &= ~USART_CR1_TXEIE;
+    }
+}
+
+static void Uart_TakeText(char *dst) {
+    __disable_irq();
+    memcpy(dst, uart_text, sizeof(uart_text));
+    __enable_irq();
+}
+
+// 이벤트 종류 → 응답에 넣을 명령 번호
+static uint8_t Uart_EventCmd(uint32_t word) {
+    switch((EventType_t)EVT_TYPE(word)) {
+        case EVT_EXPR:   return PROTO_CMD_EXPR;
+        case EVT_TEXT:   return PROTO_CMD_TEXT;
+        case EVT_BRIGHT: return PROTO_CMD_BRIGHT;
+        default:         return PROTO_CMD_BLINK;
+    }
+}
+
+#endif
+
+static void Evt_Apply(uint32_t word) {
+    uint16_t arg = EVT_ARG(word);
+#if PARK_ENABLE
+    park_tick = HAL_GetTick();
+#endif
+    switch((EventType_t)EVT_TYPE(word)) {
+        case EVT_EXPR:
+            if(arg <= EXPR_LOOK_DOWN) Anim_SetExpr((Expression_t)arg);
+            break;
+        case EVT_BLINK:       Anim_Blink(); break;
+        case EVT_WINK_L:      Anim_WinkL(); break;
+        case EVT_WINK_R:      Anim_WinkR(); break;
+        case EVT_LOOK_AROUND: Anim_LookAround(); break;
+        case EVT_TEXT: {
+#if UART_ENABLE
+            char text[PROTO_MAX_PAYLOAD + 1];
+            Uart_TakeText(text);
+            Status_SetText(text);
+#endif
+            break;
+        }
+        case EVT_BRIGHT:
+            LCD_SetBrightness((uint8_t)arg);     // CABC 백라이트 (배선된 모듈만)
+            LCD_SetFade((uint8_t)arg);           // 감마 / 전원 레지스터 (모든 모듈)
+            break;
+    }
+}
+
+// 이벤트 하나 적용 + 응답
+static void Evt_Handle(uint32_t word, uint32_t stamp) {
+    Evt_Apply(word);
+    uint32_t us = Evt_Latency(stamp);   // 해당 프레임 전송 완료 시점까지
+#if UART_ENABLE
+    if(word & EVT_REPLY) Uart_Reply(Uart_EventCmd(word), EVT_SEQ(word), PROTO_OK, us);
+#else
+    (void)us;
+#endif
+}
+
+// 프레임 경계에서 호출: 높은 우선순위부터, 호출당 최대 한 바퀴만 처리
+static void Evt_Dispatch(void) {
+    uint32_t word, stamp;
+
+    for(uint8_t p = 0; p < EVT_PRIO_COUNT; p++) {
+        for(uint8_t n = 0; n < EVT_QUEUE_SIZE && Evt_Pop(&evt_ring[p], &word, &stamp); n++) {
+            Evt_Handle(word, stamp);
+        }
+    }
+
+    uint32_t mail;
+    do {
+        mail = __LDREXW(&gaze_mail);
+        stamp = gaze_mail_stamp;     // 같은 LDREX / STREX 안에서 읽어 목표와 짝을 맞춤
+    } while(__STREXW(0, &gaze_mail));
+    if(mail & GAZE_MAIL_VALID) {
+        Anim_Gaze((int8_t)(mail >> 8), (int8_t)mail);
+#if PARK_ENABLE
+        park_tick = HAL_GetTick();
+#endif
+        uint32_t us = Evt_Latency(stamp);
+#if UART_ENABLE
+        if(mail & GAZE_MAIL_REPLY) Uart_Reply(PROTO_CMD_GAZE, (uint8_t)(mail >> 16), PROTO_OK, us);
+#else
+        (void)us;
+#endif
+    }
+}
+
+// 분할 채우기 슬라이스 사이 (lcd_poll): 레지스터만 쓰는 이벤트만 처리 (채우기는 RAMWRC 로 이어 씀)
+// 그리는 이벤트가 맨 앞이면 순서를 지키려고 그 우선순위는 멈추고 다음 프레임 경계로 남김
+// → 바깥 프레임의 측정 / 조절기 보정이 끼어든 그리기로 흐트러지지 않음. 시선 메일함도 그리므로 그대로 둠
+static void Evt_Poll(void) {
+    uint32_t word, stamp;
+
+    for(uint8_t p = 0; p < EVT_PRIO_COUNT; p++) {
+        for(uint8_t n = 0; n < EVT_QUEUE_SIZE && Evt_Peek(&evt_ring[p], &word); n++) {
+            if(EVT_TYPE(word) != EVT_BRIGHT || !Evt_Pop(&evt_ring[p], &word, &stamp)) break;
+            Evt_Handle(word, stamp);
+        }
+    }
 }
 
 // ============================================================================
@@ -601,7 +3719,7 @@ static void MX_GPIO_Init(void) {
     __HAL_RCC_GPIOB_CLK_ENABLE();
 
     // 초기 상태
-    HAL_GPIO_WritePin(GPIOC, GPIO_PIN_1, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(GPIOC, GPIO_PIN_1, GPIO_PIN_SET);     // RST 는 LCD_Init 에서만 내림 (웜 재개)
     HAL_GPIO_WritePin(GPIOA, GPIO_PIN_0|GPIO_PIN_1|GPIO_PIN_4, GPIO_PIN_SET);
     HAL_GPIO_WritePin(GPIOB, GPIO_PIN_0, GPIO_PIN_SET);
 
@@ -665,22 +3783,69 @@ int main(void) {
     HAL_Init();
     SystemClock_Config();
     MX_GPIO_Init();
-
-    LCD_Init();
-    LCD_Fill(0x0000);  // Black
+    Perf_Init();
+
+    uint8_t warm = 0;
+#if PARK_ENABLE
+    warm = LCD_Resume();         // 설정된 패널이면 SLPOUT 만, 화면 유지
+#endif
+    if(!warm) {
+        LCD_Init();
+        LCD_Fill(0x0000);  // Black
+#if BOOT_LOGO
+        LCD_BlitBusWords((LCD_W - BOOT_LOGO_W) / 2, (LCD_H - BOOT_LOGO_H) / 2, BOOT_LOGO_W, BOOT_LOGO_H, boot_logo_bus);
+        HAL_Delay(1000);
+        LCD_Fill(0x0000);
+#endif
+    }
+    frame_stats.fps_tick = HAL_GetTick();
+#if HUD_ENABLE
+    HUD_Init();
+#endif
 
     srand(HAL_GetTick());
-
-    Anim_SetExpr(EXPR_NORMAL);
-    HAL_Delay(500);
+    Evt_Init();
+    Layers_Init();
+#if UART_ENABLE
+    Uart_Init();
+#endif
+
+    uint8_t resumed = 0;
+#if PARK_ENABLE
+    if(warm) resumed = Park_Restore();   // 마지막 얼굴을 다시 그리지 않음
+    if(warm && !resumed) LCD_Fill(0x0000);   // 이어받을 장면이 없으면 여백 / HUD 줄까지 콜드 부팅처럼 지움
+    park_tick = HAL_GetTick();
+#endif
+    lcd_poll = Evt_Poll;             // 부팅 화면 이후: 큰 채우기 (Eye_Clear 등) 슬라이스 사이에도 밝기 처리
+    Chunk_SetBudget(EVT_POLL_US);
+    if(!resumed) {
+        Anim_SetExpr(EXPR_NORMAL);
+        Anim_Wait(500);
+    }
 
     while(1) {
-        // 데모 모드
+#if UART_ENABLE
+        // 시리얼 제어 모드: 명령은 프레임 사이에 처리, 없으면 Idle 동작
+        Evt_Dispatch();
+        Gov_Service();
+        Anim_Idle();
+#if PARK_ENABLE && PARK_IDLE_MS
+        if(HAL_GetTick() - park_tick > PARK_IDLE_MS) Power_Standby();
+#endif
+#else
+        // 데모 모드 (ISR 이벤트는 한 바퀴 사이에 처리)
+        Evt_Dispatch();
+        Status_SetText("DEMO");      // 바뀐 글자만 보내므로 두 번째 바퀴부터 0바이트
         Anim_Demo();
+#if PARK_ENABLE && PARK_IDLE_MS
+        if(HAL_GetTick() - park_tick > PARK_IDLE_MS) Power_Standby();
+#endif
 
-        // 또는 Idle 모드
+        // 또는 Idle 모드 (ISR 이벤트는 프레임 사이에 처리)
+        // Evt_Dispatch();
         // Anim_Idle();
         // HAL_Delay(20);
+#endif
     }
 }
 
@@ -0,0 +1,147 @@
+/*
+ * busenc.c
+ *
+ * Converts a binary PPM (P6) image into pre-encoded GPIO BSRR word triples
+ * for LCD_BlitBusWords() in main.c, and reports the flash cost.
+ *
+ * Build:  gcc -O2 -Wall -o busenc tools/busenc.c
+ * Usage:  ./busenc logo.ppm boot_logo > boot_logo_bus.h
+ *
+ * Each bus byte becomes three words { GPIOA, GPIOB, GPIOC }. The GPIOA word
+ * also pulls WR (PA1) low, so the target only has to raise WR afterwards.
+ * The pin map below must match LCD_Write8Fast() in main.c:
+ *   D0=PA9, D1=PC7, D2=PA10, D3=PB3, D4=PB5, D5=PB4, D6=PB10, D7=PA8
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+#define PIN(n)      (1UL << (n))
+#define WR_PIN      PIN(1)
+
+typedef struct {
+    uint8_t bit;        // Data bit mask
+    uint8_t port;       // 0 = GPIOA, 1 = GPIOB, 2 = GPIOC
+    uint32_t pin;
+} BusPin;
+
+static const BusPin bus_pins[8] = {
+    { 0x01, 0, PIN(9)  },   // D0
+    { 0x02, 2, PIN(7)  },   // D1
+    { 0x04, 0, PIN(10) },   // D2
+    { 0x08, 1, PIN(3)  },   // D3
+    { 0x10, 1, PIN(5)  },   // D4
+    { 0x20, 1, PIN(4)  },   // D5
+    { 0x40, 1, PIN(10) },   // D6
+    { 0x80, 0, PIN(8)  },   // D7
+};
+
+// Same encoding as LCD_Write8Fast: set bits in [15:0], reset bits in [31:16]
+static void encode_byte(uint8_t data, uint32_t words[3]) {
+    uint32_t set[3] = { 0, 0, 0 };
+    uint32_t clr[3] = { 0, 0, 0 };
+
+    for (int i = 0; i < 8; i++) {
+        if (data & bus_pins[i].bit) set[bus_pins[i].port] |= bus_pins[i].pin;
+        else clr[bus_pins[i].port] |= bus_pins[i].pin;
+    }
+    clr[0] |= WR_PIN;   // WR low rides along with the GPIOA store
+
+    for (int p = 0; p < 3; p++) words[p] = set[p] | (clr[p] << 16);
+}
+
+// Skip whitespace and '#' comments in a PPM header
+static int ppm_next_int(FILE *f) {
+    int c, v = 0;
+
+    for (;;) {
+        c = fgetc(f);
+        if (c == '#') {
+            while (c != '\n' && c != EOF) c = fgetc(f);
+        } else if (!isspace(c)) {
+            break;
+        }
+    }
+    if (!isdigit(c)) return -1;
+    while (isdigit(c)) {
+        v = v * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return v;   // Single whitespace after the value is consumed
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s image.ppm name > name_bus.h\n", argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    char magic[2];
+    if (fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || magic[1] != '6') {
+        fprintf(stderr, "%s: not a binary PPM (P6)\n", argv[1]);
+        return 1;
+    }
+
+    int w = ppm_next_int(f);
+    int h = ppm_next_int(f);
+    int maxval = ppm_next_int(f);
+    if (w <= 0 || h <= 0 || w > 240 || h > 320 || maxval <= 0 || maxval > 255) {
+        fprintf(stderr, "%s: unsupported size %dx%d or maxval %d (max 240x320, 8-bit)\n",
+                argv[1], w, h, maxval);
+        return 1;
+    }
+
+    size_t npix = (size_t)w * h;
+    uint8_t *rgb = malloc(npix * 3);
+    if (!rgb || fread(rgb, 3, npix, f) != npix) {
+        fprintf(stderr, "%s: truncated pixel data\n", argv[1]);
+        return 1;
+    }
+    fclose(f);
+
+    const char *name = argv[2];
+    char upper[64];
+    size_t n = strlen(name);
+    if (n >= sizeof(upper)) n = sizeof(upper) - 1;
+    for (size_t i = 0; i < n; i++) upper[i] = (char)toupper((unsigned char)name[i]);
+    upper[n] = '\0';
+
+    size_t raw_bytes = npix * 2;
+    size_t flash_bytes = npix * 2 * 3 * sizeof(uint32_t);
+
+    printf("/* Generated by tools/busenc.c from %s - do not edit */\n", argv[1]);
+    printf("/* %dx%d px, %zu bus bytes, %zu flash bytes */\n\n", w, h, raw_bytes, flash_bytes);
+    printf("#define %s_W  %d\n", upper, w);
+    printf("#define %s_H  %d\n\n", upper, h);
+    printf("static const uint32_t %s_bus[%zu] = {\n", name, npix * 2 * 3);
+
+    for (size_t i = 0; i < npix; i++) {
+        uint8_t r = rgb[i * 3 + 0] * 255 / maxval;
+        uint8_t g = rgb[i * 3 + 1] * 255 / maxval;
+        uint8_t b = rgb[i * 3 + 2] * 255 / maxval;
+        uint16_t c = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+        uint32_t hi[3], lo[3];
+
+        encode_byte(c >> 8, hi);
+        encode_byte(c & 0xFF, lo);
+        printf("    0x%08lX, 0x%08lX, 0x%08lX, 0x%08lX, 0x%08lX, 0x%08lX,\n",
+               (unsigned long)hi[0], (unsigned long)hi[1], (unsigned long)hi[2],
+               (unsigned long)lo[0], (unsigned long)lo[1], (unsigned long)lo[2]);
+    }
+    printf("};\n");
+
+    fprintf(stderr, "%s: %dx%d px, RGB565 %zu B, bus words %zu B flash (x%zu)\n",
+            name, w, h, raw_bytes, flash_bytes, flash_bytes / raw_bytes);
+
+    free(rgb);
+    return 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * hal_host.c
+ *
+ * Register storage and HAL functions for the host shim (see main.h).
+ * Time is simulated: the cycle counter advances HOST_CYCLES_PER_BYTE per bus
+ * byte (about what LCD_Write8Fast costs at 64 MHz), and HAL_GetTick / HAL_Delay
+ * are derived from it so busy-wait loops in main.c still terminate.
+ */
+
+#include "main.h"
+
+#define HOST_CYCLES_PER_BYTE    20
+#define HOST_CYCLES_PER_MS      64000u
+
+static GPIO_TypeDef gpio[4];
+static USART_TypeDef usart2;
+static DWT_Type dwt;
+static CoreDebug_Type core_debug;
+static BKP_TypeDef bkp;
+
+GPIO_TypeDef *GPIOA = &gpio[0], *GPIOB = &gpio[1], *GPIOC = &gpio[2], *GPIOD = &gpio[3];
+USART_TypeDef *USART2 = &usart2;
+DWT_Type *DWT = &dwt;
+CoreDebug_Type *CoreDebug = &core_debug;
+BKP_TypeDef *BKP = &bkp;
+uint32_t SystemCoreClock = 64000000;
+
+uint8_t host_rs = 1;
+
+// D0=PA9, D1=PC7, D2=PA10, D3=PB3, D4=PB5, D5=PB4, D6=PB10, D7=PA8 (set bits in BSRR[15:0])
+void Host_BusStrobe(void) {
+    uint32_t a = GPIOA->BSRR, b = GPIOB->BSRR, c = GPIOC->BSRR;
+    uint8_t d = 0;
+
+    if (a & GPIO_PIN_9)  d |= 0x01;
+    if (c & GPIO_PIN_7)  d |= 0x02;
+    if (a & GPIO_PIN_10) d |= 0x04;
+    if (b & GPIO_PIN_3)  d |= 0x08;
+    if (b & GPIO_PIN_5)  d |= 0x10;
+    if (b & GPIO_PIN_4)  d |= 0x20;
+    if (b & GPIO_PIN_10) d |= 0x40;
+    if (a & GPIO_PIN_8)  d |= 0x80;
+
+    dwt.CYCCNT += HOST_CYCLES_PER_BYTE;
+    Host_Bus(host_rs, d);
+}
+
+__attribute__((weak)) uint8_t Host_BusIn(void) {
+    return 0x00;
+}
+
+void Host_BusRead(void) {
+    uint8_t d = Host_BusIn();
+
+    GPIOA->IDR = ((d & 0x01) ? GPIO_PIN_9 : 0) | ((d & 0x04) ? GPIO_PIN_10 : 0) | ((d & 0x80) ? GPIO_PIN_8 : 0);
+    GPIOB->IDR = ((d & 0x08) ? GPIO_PIN_3 : 0) | ((d & 0x10) ? GPIO_PIN_5 : 0) |
+                 ((d & 0x20) ? GPIO_PIN_4 : 0) | ((d & 0x40) ? GPIO_PIN_10 : 0);
+    GPIOC->IDR = (d & 0x02) ? GPIO_PIN_7 : 0;
+    dwt.CYCCNT += HOST_CYCLES_PER_BYTE;
+}
+
+int HAL_Init(void) { return HAL_OK; }
+
+void HAL_Delay(uint32_t ms) {
+    dwt.CYCCNT += ms * HOST_CYCLES_PER_MS;
+}
+
+uint32_t HAL_GetTick(void) {
+    dwt.CYCCNT += 64;            // Each poll costs a microsecond
+    return dwt.CYCCNT / HOST_CYCLES_PER_MS;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init) { (void)port; (void)init; }
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state) {
+    if (state) port->ODR |= pin;
+    else port->ODR &= ~(uint32_t)pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin) {
+    return (port->IDR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+int HAL_RCC_OscConfig(RCC_OscInitTypeDef *init) { (void)init; return HAL_OK; }
+int HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *init, uint32_t latency) { (void)init; (void)latency; return HAL_OK; }
+uint32_t HAL_RCC_GetPCLK1Freq(void) { return SystemCoreClock / 2; }
+
+void HAL_PWR_EnableBkUpAccess(void) {}
+void HAL_PWR_EnterSTANDBYMode(void) {}
@@ -0,0 +1,2 @@
+/* Case-sensitive file systems: main.c and ili9341.c include "ili9341.h" */
+#include "../../Ili9341.h"
@@ -0,0 +1,40 @@
+/*
+ * main.h (host shim)
+ *
+ * Replaces the CubeMX main.h when main.c is built on Linux by a tool in
+ * tools/. Defining LCD_HOST makes main.c take the pin macros below: RS is
+ * tracked in a variable, and every rising WR edge (where the panel latches
+ * the data) hands the byte currently on the data pins, i.e. the last BSRR
+ * words written to GPIOA/B/C, to Host_BusStrobe(). Pre-encoded bus words
+ * pull WR low inside their GPIOA store, so only the rising edge is visible.
+ * A falling RD edge asks Host_BusIn() for the byte the panel drives and puts
+ * it on the data pins' IDR bits; tools that do not emulate reads get 0x00.
+ */
+
+#ifndef HOST_MAIN_H_
+#define HOST_MAIN_H_
+
+#include "stm32f1xx_hal.h"
+
+#define LCD_HOST        1
+
+extern uint8_t host_rs;             // 0 = command, 1 = data
+void Host_BusStrobe(void);          // hal_host.c: decode D0..D7, call Host_Bus()
+void Host_Bus(uint8_t rs, uint8_t data);   // provided by the tool
+void Host_BusRead(void);            // hal_host.c: Host_BusIn() -> IDR of D0..D7
+uint8_t Host_BusIn(void);           // optional in the tool (weak default: 0x00)
+
+#define LCD_CS_LOW()    ((void)0)
+#define LCD_CS_HIGH()   ((void)0)
+#define LCD_RS_LOW()    (host_rs = 0)
+#define LCD_RS_HIGH()   (host_rs = 1)
+#define LCD_WR_LOW()    ((void)0)
+#define LCD_WR_HIGH()   Host_BusStrobe()
+#define LCD_RD_LOW()    Host_BusRead()
+#define LCD_RD_HIGH()   ((void)0)
+#define LCD_RST_LOW()   ((void)0)
+#define LCD_RST_HIGH()  ((void)0)
+
+void Error_Handler(void);
+
+#endif /* HOST_MAIN_H_ */
@@ -0,0 +1,121 @@
+/*
+ * stm32f1xx_hal.h (host shim)
+ *
+ * Just enough of the STM32F1 HAL / CMSIS surface to compile main.c and
+ * ili9341.c on Linux for the diagnostics in tools/. Registers are plain
+ * memory; hal_host.c provides the storage and the few functions.
+ */
+
+#ifndef HOST_STM32F1XX_HAL_H_
+#define HOST_STM32F1XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct { volatile uint32_t CRL, CRH, IDR, ODR, BSRR, BRR, LCKR; } GPIO_TypeDef;
+typedef struct { volatile uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR; } USART_TypeDef;
+typedef struct { volatile uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+typedef struct { volatile uint32_t DR1, DR2, DR3, DR4, DR5, DR6, DR7, DR8, DR9, DR10; } BKP_TypeDef;
+
+extern GPIO_TypeDef *GPIOA, *GPIOB, *GPIOC, *GPIOD;
+extern USART_TypeDef *USART2;
+extern DWT_Type *DWT;
+extern CoreDebug_Type *CoreDebug;
+extern BKP_TypeDef *BKP;
+extern uint32_t SystemCoreClock;
+
+#define GPIO_PIN_0      0x0001u
+#define GPIO_PIN_1      0x0002u
+#define GPIO_PIN_2      0x0004u
+#define GPIO_PIN_3      0x0008u
+#define GPIO_PIN_4      0x0010u
+#define GPIO_PIN_5      0x0020u
+#define GPIO_PIN_6      0x0040u
+#define GPIO_PIN_7      0x0080u
+#define GPIO_PIN_8      0x0100u
+#define GPIO_PIN_9      0x0200u
+#define GPIO_PIN_10     0x0400u
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+typedef struct { uint32_t Pin, Mode, Pull, Speed; } GPIO_InitTypeDef;
+
+#define GPIO_MODE_INPUT         0
+#define GPIO_MODE_OUTPUT_PP     1
+#define GPIO_MODE_AF_PP         2
+#define GPIO_NOPULL             0
+#define GPIO_PULLUP             1
+#define GPIO_SPEED_FREQ_HIGH    3
+
+typedef struct { int PLLState, PLLSource, PLLMUL; } RCC_PLLInitTypeDef;
+typedef struct { int OscillatorType, HSIState, HSICalibrationValue; RCC_PLLInitTypeDef PLL; } RCC_OscInitTypeDef;
+typedef struct { int ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider; } RCC_ClkInitTypeDef;
+
+#define RCC_OSCILLATORTYPE_HSI      1
+#define RCC_HSI_ON                  1
+#define RCC_HSICALIBRATION_DEFAULT  16
+#define RCC_PLL_ON                  1
+#define RCC_PLLSOURCE_HSI_DIV2      0
+#define RCC_PLL_MUL16               16
+#define RCC_CLOCKTYPE_HCLK          1
+#define RCC_CLOCKTYPE_SYSCLK        2
+#define RCC_CLOCKTYPE_PCLK1         4
+#define RCC_CLOCKTYPE_PCLK2         8
+#define RCC_SYSCLKSOURCE_PLLCLK     2
+#define RCC_SYSCLK_DIV1             1
+#define RCC_HCLK_DIV1               1
+#define RCC_HCLK_DIV2               2
+#define FLASH_LATENCY_2             2
+#define HAL_OK                      0
+
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_GPIOD_CLK_ENABLE()    ((void)0)
+#define __HAL_RCC_USART2_CLK_ENABLE()   ((void)0)
+#define __HAL_RCC_PWR_CLK_ENABLE()      ((void)0)
+#define __HAL_RCC_BKP_CLK_ENABLE()      ((void)0)
+
+#define USART_SR_FE         (1u << 1)
+#define USART_SR_NE         (1u << 2)
+#define USART_SR_ORE        (1u << 3)
+#define USART_SR_RXNE       (1u << 5)
+#define USART_SR_TXE        (1u << 7)
+#define USART_CR1_RE        (1u << 2)
+#define USART_CR1_TE        (1u << 3)
+#define USART_CR1_RXNEIE    (1u << 5)
+#define USART_CR1_TXEIE     (1u << 7)
+#define USART_CR1_UE        (1u << 13)
+
+typedef enum { USART2_IRQn = 38 } IRQn_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Msk  (1u << 24)
+#define DWT_CTRL_CYCCNTENA_Msk      1u
+
+int HAL_Init(void);
+void HAL_Delay(uint32_t ms);
+uint32_t HAL_GetTick(void);
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+int HAL_RCC_OscConfig(RCC_OscInitTypeDef *init);
+int HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *init, uint32_t latency);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+void HAL_PWR_EnableBkUpAccess(void);
+void HAL_PWR_EnterSTANDBYMode(void);
+
+// Single-threaded host: exclusive access always succeeds, interrupts never run
+static inline uint32_t __LDREXW(volatile uint32_t *p) { return *p; }
+static inline uint32_t __STREXW(uint32_t v, volatile uint32_t *p) { *p = v; return 0; }
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t pm) { (void)pm; }
+static inline void NVIC_EnableIRQ(IRQn_Type irq) { (void)irq; }
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t prio) { (void)irq; (void)prio; }
+
+#define __NOP()             ((void)0)
+#define __DMB()             ((void)0)
+#define __CLREX()           ((void)0)
+#define __disable_irq()     ((void)0)
+#define __enable_irq()      ((void)0)
+
+#endif /* HOST_STM32F1XX_HAL_H_ */
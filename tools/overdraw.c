@@ -0,0 +1,322 @@
+/*
+ * overdraw.c
+ *
+ * Per-pixel overdraw diagnostic for main.c, runs without hardware.
+ * main.c is compiled in with the host shim (tools/host). The 8080 bus is
+ * decoded back into GRAM writes, so each expression's renders can be
+ * counted per pixel and attributed to the drawing primitive that issued them.
+ *
+ * Build (from the repository root):
+ *   gcc -O1 -Itools/host -finstrument-functions \
+ *       -finstrument-functions-exclude-file-list=hal_host,ili9341,eye_proto \
+ *       -o overdraw tools/overdraw.c tools/host/hal_host.c ili9341.c eye_proto.c -lm
+ * Add -DEYE_SHADING=1 to measure the gradient-shaded eye body (main.c's
+ * feature switches can all be set this way).
+ *
+ * Usage:  ./overdraw [-o dir] [-g] [-v]
+ *   -o dir  write heat maps to dir (default: current directory)
+ *   -g      PGM with raw write counts x32 instead of the colour-ramp PPM
+ *   -v      per-primitive breakdown for every expression
+ *
+ * Every expression is rendered twice:
+ *   raster  Eye_Clear + each shape rasterized straight from the primitives
+ *           (LCD_RoundRect, LCD_FillCircle, LCD_ThickLine, ...)
+ *   frame   Draw_Expression as the firmware runs it (span cache, tiles, governor)
+ *
+ * Heat maps cover the eye area: <expr>_<mode>.ppm. The colours are black for
+ * 0 writes, blue for 1, green for 2, yellow for 3 and red for 4 or more. A
+ * primitive's "wasted" writes were later overwritten by another write to the
+ * same pixel. Its "redundant" writes stored the colour the pixel already had.
+ */
+
+#define main eye_main                 // main.c's entry point is not used
+#include "../main.c"
+#undef main
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NO_INSTR __attribute__((no_instrument_function))
+
+static const char *const expr_names[] = {
+    "normal", "happy", "sad", "angry", "surprised", "sleepy", "wink_left", "wink_right",
+    "blink", "love", "dizzy", "look_left", "look_right", "look_up", "look_down"
+};
+_Static_assert(sizeof(expr_names) / sizeof(expr_names[0]) == EXPR_LOOK_DOWN + 1,
+               "expr_names must match Expression_t");
+
+// ============================================================================
+// Primitive attribution (outermost listed function on the call stack)
+// ============================================================================
+
+typedef struct {
+    const char *name;
+    void *fn;
+    uint32_t writes;
+    uint32_t wasted;
+    uint32_t redundant;
+} Prim_t;
+
+#define PRIM(f)     { #f, (void *)(f), 0, 0, 0 }
+
+static Prim_t prims[] = {
+    PRIM(Eye_Clear),
+    PRIM(LCD_RoundRect),
+    PRIM(LCD_ThickLine),
+    PRIM(LCD_FillCircle),
+#if EYE_SHADING
+    PRIM(LCD_RoundRectGradV),
+#endif
+    PRIM(Span_Replay),
+    PRIM(Span_ReplayCoarse),
+    PRIM(Sprite_MoveTo),
+    PRIM(LCD_DrawText),
+    PRIM(LCD_FillRectSliced),
+    PRIM(LCD_DrawSpans),
+    PRIM(LCD_FillRectFast),
+    PRIM(LCD_HLineFast),
+    { "(other)", NULL, 0, 0, 0 },
+};
+
+#define PRIM_COUNT      (int)(sizeof(prims) / sizeof(prims[0]))
+#define PRIM_OTHER      (PRIM_COUNT - 1)
+
+static int call_depth = 0;
+static int prim_cur = PRIM_OTHER;
+static int prim_depth = -1;          // depth at which prim_cur was entered
+
+NO_INSTR void __cyg_profile_func_enter(void *fn, void *site) {
+    (void)site;
+    call_depth++;
+    if (prim_cur != PRIM_OTHER) return;
+    for (int i = 0; i < PRIM_OTHER; i++) {
+        if (prims[i].fn == fn) {
+            prim_cur = i;
+            prim_depth = call_depth;
+            return;
+        }
+    }
+}
+
+NO_INSTR void __cyg_profile_func_exit(void *fn, void *site) {
+    (void)fn;
+    (void)site;
+    if (call_depth == prim_depth) {
+        prim_cur = PRIM_OTHER;
+        prim_depth = -1;
+    }
+    call_depth--;
+}
+
+// ============================================================================
+// GRAM emulation (CASET / PASET / RAMWR / RAMWRC)
+// ============================================================================
+
+static uint16_t gram[LCD_H][LCD_W];
+static uint8_t writes[LCD_H][LCD_W];
+static int8_t last_prim[LCD_H][LCD_W];
+
+static uint8_t bus_cmd;
+static uint8_t bus_arg[4];
+static uint8_t bus_argn;
+static int bus_hi = -1;
+static uint16_t col0, col1 = LCD_W - 1, row0, row1 = LCD_H - 1, wx, wy;
+static uint32_t bus_bytes;
+
+NO_INSTR static void Gram_Write(uint16_t x, uint16_t y, uint16_t color) {
+    if (x >= LCD_W || y >= LCD_H) return;
+
+    Prim_t *p = &prims[prim_cur];
+    p->writes++;
+    if (writes[y][x]) {
+        prims[last_prim[y][x]].wasted++;
+        if (gram[y][x] == color) p->redundant++;
+    }
+    if (writes[y][x] < 255) writes[y][x]++;
+    last_prim[y][x] = (int8_t)prim_cur;
+    gram[y][x] = color;
+}
+
+NO_INSTR void Host_Bus(uint8_t rs, uint8_t d) {
+    bus_bytes++;
+    if (!rs) {
+        bus_cmd = d;
+        bus_argn = 0;
+        bus_hi = -1;
+        if (d == 0x2C) { wx = col0; wy = row0; }
+        return;
+    }
+
+    switch (bus_cmd) {
+    case 0x2A:
+    case 0x2B:
+        if (bus_argn < 4) bus_arg[bus_argn++] = d;
+        if (bus_argn == 4) {
+            uint16_t a = (bus_arg[0] << 8) | bus_arg[1], b = (bus_arg[2] << 8) | bus_arg[3];
+            if (bus_cmd == 0x2A) { col0 = a; col1 = b; }
+            else { row0 = a; row1 = b; }
+        }
+        break;
+    case 0x2C:
+    case 0x3C:
+        if (bus_hi < 0) { bus_hi = d; break; }
+        Gram_Write(wx, wy, (uint16_t)((bus_hi << 8) | d));
+        bus_hi = -1;
+        if (++wx > col1) {
+            wx = col0;
+            if (++wy > row1) wy = row0;
+        }
+        break;
+    }
+}
+
+// ============================================================================
+// Runs
+// ============================================================================
+
+typedef struct {
+    uint32_t writes, pixels, wasted, redundant, bytes;
+} RunStats_t;
+
+static void Run_Reset(void) {
+    memset(gram, 0, sizeof(gram));
+    memset(writes, 0, sizeof(writes));
+    for (int i = 0; i < PRIM_COUNT; i++) prims[i].writes = prims[i].wasted = prims[i].redundant = 0;
+    bus_bytes = 0;
+}
+
+static void Run_Collect(RunStats_t *s) {
+    memset(s, 0, sizeof(*s));
+    for (int y = 0; y < LCD_H; y++) {
+        for (int x = 0; x < LCD_W; x++) {
+            if (!writes[y][x]) continue;
+            s->writes += writes[y][x];
+            s->pixels++;
+        }
+    }
+    for (int i = 0; i < PRIM_COUNT; i++) {
+        s->wasted += prims[i].wasted;
+        s->redundant += prims[i].redundant;
+    }
+    s->bytes = bus_bytes;
+}
+
+// Shapes straight from the primitives, as Draw_Part does without the span cache
+static void Render_Raster(Expression_t e) {
+    int16_t gx = 0, gy = 0;
+
+    Eye_Clear();
+    Expr_Gaze(e, 0, 0, &gx, &gy);
+    for (int i = 0; i < EXPR_PARTS_MAX; i++) {
+        const EyePart_t *p = &expr_parts[e][i];
+        if (p->shape == SHAPE_NONE) break;
+        int16_t ox = (p->flags & PART_GAZE) ? gx : 0;
+        int16_t oy = (p->flags & PART_GAZE) ? gy : 0;
+        Shape_Raster(p->shape, (p->flags & PART_R) ? eye.rx : eye.lx, ox, oy, !(p->flags & PART_MIRROR));
+    }
+}
+
+// Firmware path from a black screen with nothing known about it
+static void Render_Frame(Expression_t e) {
+#if TILE_ENABLE
+    memset(tile_hash, 0, sizeof(tile_hash));
+#endif
+    glint_live = 0;
+    eye_shown = 0;
+    current_expr = e;
+    Draw_Expression(e, 0, 0);
+    Gov_Flush();             // bands the firmware would spread over later frame slots
+}
+
+static const uint8_t heat_ramp[5][3] = {
+    { 0, 0, 0 }, { 0, 64, 255 }, { 0, 200, 0 }, { 255, 220, 0 }, { 255, 0, 0 }
+};
+
+static int Heat_Write(const char *dir, const char *expr, const char *mode, int pgm) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s_%s.%s", dir, expr, mode, pgm ? "pgm" : "ppm");
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "%s\n%d %d\n255\n", pgm ? "P5" : "P6", EYE_AREA_W, EYE_AREA_H);
+    for (int y = EYE_AREA_Y; y < EYE_AREA_Y + EYE_AREA_H; y++) {
+        for (int x = EYE_AREA_X; x < EYE_AREA_X + EYE_AREA_W; x++) {
+            uint8_t n = writes[y][x];
+            if (pgm) {
+                fputc(n >= 8 ? 255 : n * 32, f);
+            } else {
+                fwrite(heat_ramp[n > 4 ? 4 : n], 1, 3, f);
+            }
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static void Print_Run(const char *expr, const char *mode, const RunStats_t *s) {
+    printf("%-11s %-6s %7u %7u %7u %5.1f%% %7u %8u\n", expr, mode, s->writes, s->pixels, s->wasted,
+           s->writes ? 100.0 * s->wasted / s->writes : 0.0, s->redundant, s->bytes);
+}
+
+static void Print_Prims(const Prim_t *p, int indent) {
+    for (int i = 0; i < PRIM_COUNT; i++) {
+        if (!p[i].writes && !p[i].wasted) continue;
+        printf("%*s%-22s %8u writes %8u wasted %8u redundant\n", indent, "",
+               p[i].name, p[i].writes, p[i].wasted, p[i].redundant);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *dir = ".";
+    int pgm = 0, verbose = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-o") && i + 1 < argc) dir = argv[++i];
+        else if (!strcmp(argv[i], "-g")) pgm = 1;
+        else if (!strcmp(argv[i], "-v")) verbose = 1;
+        else {
+            fprintf(stderr, "usage: %s [-o dir] [-g] [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Perf_Init();
+    Layers_Init();
+
+    Prim_t total[2][PRIM_COUNT];
+    memset(total, 0, sizeof(total));
+
+    printf("%-11s %-6s %7s %7s %7s %6s %7s %8s\n",
+           "expr", "mode", "writes", "pixels", "wasted", "", "redund", "busbytes");
+
+    for (int e = 0; e <= EXPR_LOOK_DOWN; e++) {
+        for (int m = 0; m < 2; m++) {
+            const char *mode = m ? "frame" : "raster";
+            RunStats_t s;
+
+            Run_Reset();
+            if (m) Render_Frame((Expression_t)e);
+            else Render_Raster((Expression_t)e);
+            Run_Collect(&s);
+
+            Print_Run(expr_names[e], mode, &s);
+            if (verbose) Print_Prims(prims, 4);
+            for (int i = 0; i < PRIM_COUNT; i++) {
+                total[m][i].name = prims[i].name;
+                total[m][i].writes += prims[i].writes;
+                total[m][i].wasted += prims[i].wasted;
+                total[m][i].redundant += prims[i].redundant;
+            }
+            if (Heat_Write(dir, expr_names[e], mode, pgm) < 0) return 1;
+        }
+    }
+
+    printf("\nPer-primitive totals, raster (all expressions):\n");
+    Print_Prims(total[0], 2);
+    printf("\nPer-primitive totals, frame (all expressions):\n");
+    Print_Prims(total[1], 2);
+    return 0;
+}
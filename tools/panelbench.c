@@ -0,0 +1,191 @@
+/*
+ * panelbench.c
+ *
+ * Bus-cost benchmark for main.c on either panel, runs without hardware.
+ * main.c is compiled in with the host shim (tools/host). Every bus byte is
+ * counted, and each window is checked against the panel size.
+ *
+ * Build (from the repository root), once per panel:
+ *   gcc -O1 -Itools/host -o panelbench tools/panelbench.c \
+ *       tools/host/hal_host.c ili9341.c eye_proto.c -lm
+ *   gcc -O1 -Itools/host -DLCD_PANEL_9488=1 -o panelbench9488 tools/panelbench.c \
+ *       tools/host/hal_host.c ili9341.c eye_proto.c -lm
+ *
+ * The optional features in main.c are off by default. Each switch can be
+ * set from the command line, and the build below turns them on so that the
+ * HUD, shaded body, canvas and park/resume paths are measured as well:
+ *   gcc -O1 -Itools/host -DHUD_ENABLE=1 -DEYE_SHADING=1 -DCANVAS_ENABLE=1 \
+ *       -DPARK_ENABLE=1 -DUART_ENABLE=1 -o panelbench_all tools/panelbench.c \
+ *       tools/host/hal_host.c ili9341.c eye_proto.c -lm
+ * BOOT_LOGO also needs boot_logo_bus.h, generated by tools/busenc.c.
+ *
+ * Usage:  ./panelbench
+ *
+ * For each operation it prints bus bytes, pixels written, windows opened and
+ * the modelled bus time (tools/host/hal_host.c: 20 cycles per byte at 64 MHz).
+ * Only the full-screen fill and the full-width layers should grow with the
+ * panel. Everything else should cost the same bytes on both panels, since
+ * bus time follows the area actually updated.
+ */
+
+#define main eye_main                 // main.c's entry point is not used
+#include "../main.c"
+#undef main
+
+#include <stdio.h>
+
+static uint8_t bus_cmd;
+static uint8_t bus_arg[4];
+static uint8_t bus_argn;
+static uint32_t bus_bytes, bus_pixels, bus_windows, bus_bad;
+
+void Host_Bus(uint8_t rs, uint8_t d) {
+    bus_bytes++;
+    if (!rs) {
+        bus_cmd = d;
+        bus_argn = 0;
+        return;
+    }
+
+    switch (bus_cmd) {
+    case 0x2A:
+    case 0x2B:
+        if (bus_argn < 4) bus_arg[bus_argn++] = d;
+        if (bus_argn == 4) {
+            uint16_t a = (bus_arg[0] << 8) | bus_arg[1], b = (bus_arg[2] << 8) | bus_arg[3];
+            uint16_t lim = (bus_cmd == 0x2A) ? LCD_W : LCD_H;
+            if (a > b || b >= lim) bus_bad++;
+            if (bus_cmd == 0x2A) bus_windows++;
+        }
+        break;
+    case 0x2C:
+    case 0x3C:
+        bus_pixels++;                // Two bytes per pixel, halved when printed
+        break;
+    }
+}
+
+typedef void (*Bench_Fn)(void);
+
+static void Bench_Fill(void) {
+    LCD_Fill(EYE_BG);
+}
+
+static void Bench_Rect(void) {
+    LCD_FillRectFast(LCD_W / 2 - 50, LCD_H / 2 - 50, 100, 100, EYE_COLOR);
+}
+
+static void Bench_Layers(void) {
+    Layer_Invalidate(layer_status, 0, 0, LCD_W, LCD_H);     // clipped to each layer's bounds
+    Layer_Invalidate(layer_eyes, 0, 0, LCD_W, LCD_H);
+    Layer_Invalidate(layer_widgets, 0, 0, LCD_W, LCD_H);
+    Compositor_Present();
+}
+
+static void Bench_Happy(void) {
+    Draw_Expression(EXPR_HAPPY, 0, 0);
+    Gov_Flush();             // include any bands left for later frame slots
+}
+
+static void Bench_Normal(void) {
+    Draw_Expression(EXPR_NORMAL, 0, 0);
+    Gov_Flush();
+}
+
+static void Bench_Gaze(void) {
+    Anim_Gaze(6, -3);
+}
+
+static void Bench_Status(void) {
+    Status_SetText("EYE 42");
+}
+
+static void Bench_Widgets(void) {
+    Frame_Begin();
+    Bar_Set(&widget_battery, 40);
+    Gauge_Set(&widget_gauge, 60);
+    Digits_Set(&widget_readout, 60);
+    Frame_End();
+}
+
+#if CANVAS_ENABLE
+static void Bench_CanvasFull(void) {
+    Canvas_SetPalette(0, EYE_BG);
+    Canvas_SetPalette(1, EYE_COLOR);
+    Canvas_Clear(0);
+    Canvas_Present();
+}
+
+// One small circle: only the rows it touched are sent
+static void Bench_CanvasBall(void) {
+    Canvas_FillCircle(CANVAS_W / 2, CANVAS_H / 2, 8, 1);
+    Canvas_Present();
+}
+
+static void Bench_CanvasLeave(void) {
+    Canvas_Leave();
+}
+#endif
+
+#if PARK_ENABLE && PARK_IDLE_MS
+// Standby and warm boot without the panel: the scene goes to the backup
+// registers, the tile hashes are lost with RAM and Park_Restore rebuilds
+// them without touching the bus
+static void Bench_Park(void) {
+    Park_Save();
+    memset(tile_hash, 0, sizeof(tile_hash));
+    Park_Restore();
+}
+
+// First expression after the warm boot: only the changed tiles
+static void Bench_Resume(void) {
+    Draw_Expression(EXPR_HAPPY, 0, 0);
+    Gov_Flush();
+}
+#endif
+
+static const struct {
+    const char *name;
+    Bench_Fn fn;
+} benches[] = {
+    { "fill screen",   Bench_Fill },
+    { "rect 100x100",  Bench_Rect },
+    { "layers full",   Bench_Layers },
+    { "expr happy",    Bench_Happy },
+    { "expr normal",   Bench_Normal },
+    { "gaze step",     Bench_Gaze },
+    { "status text",   Bench_Status },
+    { "widgets step",  Bench_Widgets },
+#if CANVAS_ENABLE
+    { "canvas full",   Bench_CanvasFull },
+    { "canvas ball",   Bench_CanvasBall },
+    { "canvas leave",  Bench_CanvasLeave },
+#endif
+#if PARK_ENABLE && PARK_IDLE_MS
+    { "park resume",   Bench_Park },
+    { "resume happy",  Bench_Resume },
+#endif
+};
+
+int main(void) {
+    uint32_t bad = 0;
+
+    Perf_Init();
+    Layers_Init();
+
+    printf("panel %s %dx%d\n", LCD_PANEL->name, LCD_W, LCD_H);
+    printf("%-14s %8s %8s %6s %9s %8s\n", "op", "bytes", "pixels", "win", "bus us", "B/px");
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        bus_bytes = bus_pixels = bus_windows = bus_bad = 0;
+        uint32_t t0 = Perf_Cycles();
+        benches[i].fn();
+        uint32_t us = Perf_CyclesToUs(Perf_Cycles() - t0);
+        uint32_t px = bus_pixels / 2;
+
+        printf("%-14s %8u %8u %6u %9u %8.2f%s\n", benches[i].name, bus_bytes, px, bus_windows, us,
+               px ? (double)bus_bytes / px : 0.0, bus_bad ? "  WINDOW OUT OF PANEL" : "");
+        bad += bus_bad;
+    }
+    return bad ? 1 : 0;
+}
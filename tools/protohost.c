@@ -0,0 +1,371 @@
+/*
+ * protohost.c
+ *
+ * Headless test harness for the serial eye protocol (eye_proto.h).
+ *
+ * Build:  gcc -O2 -Wall -o protohost tools/protohost.c eye_proto.c
+ *
+ * Usage:
+ *   ./protohost serve [-f frame_us]          fake eye on a new pty (prints its path)
+ *   ./protohost serve -p [-f frame_us]       fake eye on stdin/stdout (pipe)
+ *   ./protohost bench [-n count] [-w window] [-f frame_us] [device]
+ *
+ * bench sends a mix of commands and reads the replies. It reports throughput,
+ * the round trip seen by the host and the command-to-photon latency reported
+ * by the eye. Without a device it forks a fake eye on a socketpair. With a
+ * device (e.g. /dev/ttyUSB0) it talks to real hardware at 115200 8N1.
+ *
+ * The fake eye works like main.c. It drains commands at frame boundaries, and
+ * a newer gaze target replaces a pending one. Each shown command costs one
+ * frame of frame_us.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "../eye_proto.h"
+
+#define EYE_QUEUE       16       // EVT_QUEUE_SIZE in main.c
+#define SEQ_SPACE       256
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000;
+}
+
+static int write_all(int fd, const uint8_t *buf, size_t n) {
+    while (n) {
+        ssize_t w = write(fd, buf, n);
+        if (w < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            return -1;
+        }
+        buf += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+static void reply(int fd, uint8_t cmd, uint8_t seq, uint8_t status, uint32_t latency_us) {
+    uint8_t buf[PROTO_REPLY_LEN];
+    size_t n = Proto_EncodeReply(buf, cmd, seq, status, latency_us);
+    write_all(fd, buf, n);
+}
+
+// ============================================================================
+// Fake eye
+// ============================================================================
+
+typedef struct {
+    uint8_t cmd, seq;
+    uint64_t stamp;
+} Pending_t;
+
+static int run_eye(int in, int out, unsigned frame_us) {
+    Proto_Parser_t p;
+    Pending_t q[EYE_QUEUE];
+    unsigned qn = 0;
+    Pending_t gaze = { 0, 0, 0 };
+    int gaze_valid = 0;
+    uint8_t buf[256];
+
+    Proto_Init(&p, PROTO_SYNC);
+
+    for (;;) {
+        // Wait for input only when there is nothing to show
+        struct pollfd pfd = { in, POLLIN, 0 };
+        int timeout = (qn || gaze_valid) ? 0 : -1;
+        int r = poll(&pfd, 1, timeout);
+        if (r < 0 && errno != EINTR) return 1;
+
+        if (r > 0) {
+            ssize_t n = read(in, buf, sizeof(buf));
+            if (n <= 0) return 0;     // Host closed
+            uint64_t t = now_us();
+
+            for (ssize_t i = 0; i < n; i++) {
+                uint8_t res = Proto_Feed(&p, buf[i]);
+                if (res == PROTO_BAD) {
+                    reply(out, p.frame.cmd, p.frame.seq, p.error, 0);
+                    continue;
+                }
+                if (res != PROTO_FRAME) continue;
+
+                const Proto_Frame_t *f = &p.frame;
+                uint8_t st = Proto_Check(f);
+                if (st == PROTO_OK && f->cmd == PROTO_CMD_EXPR && f->payload[0] > 14) st = PROTO_ERR_ARG;
+                if (st == PROTO_OK && f->cmd == PROTO_CMD_GAZE &&
+                    (abs((int8_t)f->payload[0]) > 8 || abs((int8_t)f->payload[1]) > 8)) st = PROTO_ERR_ARG;
+                if (st != PROTO_OK) {
+                    reply(out, f->cmd, f->seq, st, 0);
+                } else if (f->cmd == PROTO_CMD_PING) {
+                    reply(out, f->cmd, f->seq, PROTO_OK, 0);
+                } else if (f->cmd == PROTO_CMD_GAZE) {
+                    if (gaze_valid) reply(out, gaze.cmd, gaze.seq, PROTO_REPLACED, 0);
+                    gaze = (Pending_t){ f->cmd, f->seq, t };
+                    gaze_valid = 1;
+                } else if (qn >= EYE_QUEUE) {
+                    reply(out, f->cmd, f->seq, PROTO_ERR_BUSY, 0);
+                } else {
+                    q[qn++] = (Pending_t){ f->cmd, f->seq, t };
+                }
+            }
+            continue;     // Drain everything that has arrived before the next frame
+        }
+
+        // Frame boundary: queued commands first, then the latest gaze target
+        for (unsigned i = 0; i < qn; i++) {
+            usleep(frame_us);
+            reply(out, q[i].cmd, q[i].seq, PROTO_OK, (uint32_t)(now_us() - q[i].stamp));
+        }
+        qn = 0;
+        if (gaze_valid) {
+            usleep(frame_us);
+            reply(out, gaze.cmd, gaze.seq, PROTO_OK, (uint32_t)(now_us() - gaze.stamp));
+            gaze_valid = 0;
+        }
+    }
+}
+
+static int serve(int use_pipe, unsigned frame_us) {
+    if (use_pipe) return run_eye(STDIN_FILENO, STDOUT_FILENO, frame_us);
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) {
+        perror("pty");
+        return 1;
+    }
+
+    struct termios tio;
+    if (tcgetattr(master, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(master, TCSANOW, &tio);
+    }
+    printf("%s\n", ptsname(master));
+    fflush(stdout);
+    return run_eye(master, master, frame_us);
+}
+
+// ============================================================================
+// Benchmark client
+// ============================================================================
+
+typedef struct {
+    uint64_t sent_at;
+    uint8_t cmd;
+    uint8_t busy;
+} Slot_t;
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char *name, uint32_t *v, unsigned n) {
+    if (!n) {
+        printf("  %-10s -\n", name);
+        return;
+    }
+    uint64_t sum = 0;
+    for (unsigned i = 0; i < n; i++) sum += v[i];
+    qsort(v, n, sizeof(*v), cmp_u32);
+    printf("  %-10s min %6u  avg %6u  p99 %6u  max %6u us\n", name,
+           v[0], (unsigned)(sum / n), v[(n * 99) / 100], v[n - 1]);
+}
+
+// Command mix: expressions, gaze sweeps, status text, blinks, brightness and pings
+static size_t next_command(uint8_t *out, unsigned i, uint8_t seq, uint8_t *cmd) {
+    uint8_t pl[PROTO_MAX_PAYLOAD];
+    uint8_t len = 0;
+
+    switch (i % 8) {
+    case 0: case 4:
+        *cmd = PROTO_CMD_EXPR;
+        pl[len++] = (uint8_t)((i / 8) % 15);
+        break;
+    case 1: case 2: case 5:
+        *cmd = PROTO_CMD_GAZE;
+        pl[len++] = (uint8_t)(int8_t)((int)(i % 17) - 8);
+        pl[len++] = (uint8_t)(int8_t)((int)(i % 9) - 4);
+        break;
+    case 3:
+        *cmd = PROTO_CMD_TEXT;
+        len = (uint8_t)snprintf((char *)pl, sizeof(pl), "CMD %u", i);
+        break;
+    case 6:
+        *cmd = (i % 32 == 6) ? PROTO_CMD_BLINK : PROTO_CMD_BRIGHT;
+        pl[len++] = (uint8_t)((*cmd == PROTO_CMD_BLINK) ? 0 : 128 + (i & 127));
+        break;
+    default:
+        *cmd = PROTO_CMD_PING;
+        break;
+    }
+    return Proto_Encode(out, PROTO_SYNC, *cmd, seq, pl, len);
+}
+
+static int open_tty(const char *path) {
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+static int bench(unsigned count, unsigned window, unsigned frame_us, const char *device) {
+    int fd;
+    pid_t child = -1;
+
+    if (device) {
+        fd = open_tty(device);
+        if (fd < 0) return 1;
+    } else {
+        int sv[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+            perror("socketpair");
+            return 1;
+        }
+        child = fork();
+        if (child == 0) {
+            close(sv[0]);
+            _exit(run_eye(sv[1], sv[1], frame_us));
+        }
+        close(sv[1]);
+        fd = sv[0];
+    }
+
+    Slot_t slot[SEQ_SPACE];
+    memset(slot, 0, sizeof(slot));
+    uint32_t *rtt = calloc(count, sizeof(uint32_t));
+    uint32_t *photon = calloc(count, sizeof(uint32_t));
+    unsigned n_rtt = 0, n_photon = 0;
+    unsigned sent = 0, done = 0, outstanding = 0;
+    unsigned ok = 0, replaced = 0, errors = 0;
+    uint64_t bytes_out = 0;
+    Proto_Parser_t p;
+    uint8_t buf[256];
+
+    Proto_Init(&p, PROTO_REPLY_SYNC);
+    uint64_t t0 = now_us();
+
+    while (done < count) {
+        // Keep at most `window` commands in flight (the eye queue holds 16)
+        while (sent < count && outstanding < window) {
+            uint8_t frame[PROTO_FRAME_MAX];
+            uint8_t seq = (uint8_t)sent;
+            if (slot[seq].busy) break;
+            size_t n = next_command(frame, sent, seq, &slot[seq].cmd);
+            slot[seq].sent_at = now_us();
+            slot[seq].busy = 1;
+            if (write_all(fd, frame, n) < 0) {
+                perror("write");
+                return 1;
+            }
+            bytes_out += n;
+            sent++;
+            outstanding++;
+        }
+
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 2000) <= 0) {
+            fprintf(stderr, "timeout: %u of %u replies\n", done, count);
+            break;
+        }
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        uint64_t t = now_us();
+
+        for (ssize_t i = 0; i < n; i++) {
+            uint8_t res = Proto_Feed(&p, buf[i]);
+            if (res == PROTO_BAD) errors++;
+            if (res != PROTO_FRAME) continue;
+
+            Slot_t *s = &slot[p.frame.seq];
+            if (!s->busy) continue;
+            s->busy = 0;
+            outstanding--;
+            done++;
+
+            uint8_t st = p.frame.payload[0];
+            if (st == PROTO_OK) {
+                ok++;
+                rtt[n_rtt++] = (uint32_t)(t - s->sent_at);
+                if (s->cmd != PROTO_CMD_PING) photon[n_photon++] = Proto_ReplyLatency(&p.frame);
+            } else if (st == PROTO_REPLACED) {
+                replaced++;
+            } else {
+                errors++;
+            }
+        }
+    }
+
+    uint64_t elapsed = now_us() - t0;
+    if (!elapsed) elapsed = 1;
+    printf("%u commands in %.3f s: %.0f cmd/s, %.0f B/s out\n", done, elapsed / 1e6,
+           done * 1e6 / elapsed, bytes_out * 1e6 / elapsed);
+    printf("  ok %u  replaced %u  errors %u\n", ok, replaced, errors);
+    report("round trip", rtt, n_rtt);
+    report("to photon", photon, n_photon);
+
+    close(fd);
+    if (child > 0) waitpid(child, NULL, 0);
+    free(rtt);
+    free(photon);
+    return (done == count && !errors) ? 0 : 1;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s serve [-p] [-f frame_us]\n"
+                    "       %s bench [-n count] [-w window] [-f frame_us] [device]\n", prog, prog);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    unsigned count = 1000, window = 8, frame_us = 8000;
+    int use_pipe = 0;
+    const char *device = NULL;
+
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "-p")) use_pipe = 1;
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) count = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-w") && i + 1 < argc) window = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) frame_us = (unsigned)atoi(argv[++i]);
+        else if (argv[i][0] != '-') device = argv[i];
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (window < 1) window = 1;
+    if (window > EYE_QUEUE) window = EYE_QUEUE;
+
+    if (!strcmp(argv[1], "serve")) return serve(use_pipe, frame_us);
+    if (!strcmp(argv[1], "bench")) return bench(count, window, frame_us, device);
+    usage(argv[0]);
+    return 1;
+}